@@ -0,0 +1,16 @@
+#include <inttypes.h>
+#include <stdbool.h>
+
+#include <avr/pgmspace.h>
+
+#include "app.h"
+#include "video.h"
+
+/* Smallest native program: 'make apps/hello.rnx', 'load', then 'exec hello.rnx [name]' */
+static int hello(uint8_t argc, char **argv) {
+    ROS_CALL(ros_puts_P)(ATTRIBUTE_DEFAULT, USTR(PSTR("Hello from flash, ")), false);
+    ROS_CALL(ros_puts)(ATTRIBUTE_DEFAULT, USTR((argc > 1) ? argv[1] : argv[0]), true);
+    return 0;
+}
+
+ROS_APP(hello);
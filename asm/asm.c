@@ -59,7 +59,8 @@ void __attribute__((noreturn)) usage(FILE *f, int argc, const char **argv) {
                "-warn_conversions - IMM8 to IMM12 auto conversions\n\t"
                "-warn_range - Auto defaulting to IMM12/IMM8 range using \'and\' operation\n\t"
                "-warn_all - Turn on all warnings\n\t"
-               "-loadaddr <load address> - Change load address ( default - 200h )\n");
+               "-loadaddr <load address> - Change load address ( default - 200h )\n\t"
+               "-compress - Write LZSS compressed .rex, ROS unpacks it while loading\n");
     exit(EXIT_FAILURE);
 }
 
@@ -137,6 +138,11 @@ int main(int argc, const char *argv[]) {
             continue;
         }
 
+        if (!strcmp(arg, "-compress")) {
+            _compress = true;
+            continue;
+        }
+
         fprintf(stderr, "Unknown option: \"%s\".\n", arg);
         TOTAL_CLEANUP();
         exit(EXIT_FAILURE);
@@ -166,6 +172,12 @@ int main(int argc, const char *argv[]) {
         
         fclose(f);
 
+        if (_compress && (compress_output(result_path) < 0)) {
+            fprintf(stderr, "Cannot compress \"%s\".\n", result_path);
+            TOTAL_CLEANUP();
+            exit(EXIT_FAILURE);
+        }
+
         STACK_CLEANUP(blocks_cleanup, blocks_cleanup_callback);
         STACK_CLEANUP(tokens_cleanup, tokens_cleanup_callback);
     }
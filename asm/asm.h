@@ -144,6 +144,9 @@ void token_as_imm(struct Operand *self, struct Token *tok);
 void trim_string_quotes(struct Token *tok);
 
 extern volatile uint16_t _load_addr;
+extern volatile bool _compress;
+
+int compress_output(const char *path);
 
 void dump_assembler(void);
 
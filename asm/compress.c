@@ -0,0 +1,90 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <inttypes.h>
+#include <string.h>
+
+#include "common.h"
+#include "asm.h"
+#include "rexz.h"
+
+volatile bool _compress = false;
+
+/* Longest earlier match within the window, it may run into the bytes being encoded */
+static size_t longest_match(const uint8_t *data, size_t size, size_t pos, size_t *distance) {
+    const size_t first = (pos > REXZ_WINDOW) ? pos - REXZ_WINDOW : 0;
+    size_t best = 0;
+
+    for (size_t from = first; from < pos; from++) {
+        size_t len = 0;
+
+        while ((len < REXZ_MATCH_MAX) && (pos + len < size) && (data[from + len] == data[pos + len]))
+            len ++;
+
+        if (len > best) {
+            best = len;
+            *distance = pos - from;
+        }
+    }
+
+    return best;
+}
+
+/* Greedy LZSS, returns packed size. Output must hold size + size / 8 + 1 bytes */
+static size_t pack(const uint8_t *data, size_t size, uint8_t *out) {
+    size_t pos = 0, out_len = 0;
+
+    while (pos < size) {
+        const size_t flags_at = out_len ++;
+        uint8_t flags = 0;
+
+        for (int item = 0; (item < 8) && (pos < size); item++) {
+            size_t distance = 0;
+            const size_t len = longest_match(data, size, pos, &distance);
+
+            if (len >= REXZ_MATCH_MIN) {
+                out[out_len ++] = (uint8_t)(distance - 1);
+                out[out_len ++] = (uint8_t)(len - REXZ_MATCH_MIN);
+                pos += len;
+                continue;
+            }
+
+            flags |= (uint8_t)(1 << item);
+            out[out_len ++] = data[pos ++];
+        }
+
+        out[flags_at] = flags;
+    }
+
+    return out_len;
+}
+
+/* Rewrites assembled .rex as REXZ container, see include/rexz.h */
+int compress_output(const char *path) {
+    FILE *f = fopen(path, "rb");
+    if (!f)
+        return -1;
+
+    static uint8_t data[UINT16_MAX], out[UINT16_MAX + UINT16_MAX / 8 + 1];
+    const size_t size = fread(data, 1, sizeof(data), f);
+    fclose(f);
+
+    if (size == sizeof(data))
+        return -1;
+
+    struct Rexz_Header header = { .size = (uint16_t)size };
+    memcpy(header.magic, REXZ_MAGIC, sizeof(header.magic));
+
+    const size_t packed = pack(data, size, out);
+
+    if (!(f = fopen(path, "wb")))
+        return -1;
+
+    const bool written = (fwrite(&header, sizeof(header), 1, f) == 1) && (fwrite(out, 1, packed, f) == packed);
+    fclose(f);
+
+    if (!written)
+        return -1;
+
+    fprintf(stdout, ANSI_MAGENTA "Compressed" ANSI_RESET "\t\t: %zu -> %zu bytes.\n", size, sizeof(header) + packed);
+    return 0;
+}
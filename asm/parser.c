@@ -29,10 +29,11 @@ void dump_assembler(void) {
                     ANSI_MAGENTA "-warn_separate" ANSI_RESET "\t\t = %s\n"
                     ANSI_MAGENTA "-warn_conversions" ANSI_RESET "\t = %s\n"
                     ANSI_MAGENTA "-warn_range" ANSI_RESET "\t\t = %s\n"
-                    ANSI_MAGENTA "-loadaddr " ANSI_RESET "\t\t = %"PRIx16 "\n\n",
+                    ANSI_MAGENTA "-loadaddr " ANSI_RESET "\t\t = %"PRIx16 "\n"
+                    ANSI_MAGENTA "-compress" ANSI_RESET "\t\t = %s\n\n",
                     bool_as_cstr(warning_info.w_error), bool_as_cstr(warning_info.w_separate),
                     bool_as_cstr(warning_info.w_conversions), bool_as_cstr(warning_info.w_range),
-                    _load_addr);
+                    _load_addr, bool_as_cstr(_compress));
     fprintf(stdout, "Thank you for using ROS-CHIP-8 Assembler!\n");
 }
 
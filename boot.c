@@ -5,24 +5,75 @@
 #include "spi.h"
 #include "st7735.h"
 #include "keyboard.h"
+#include "spiram.h"
+#include "xram.h"
+#include "twi.h"
+#include "uart.h"
+#include "history.h"
+#include "config.h"
+#include "sched.h"
+#include "defer.h"
+#include "memstat.h"
+#include "prof.h"
 
 #include "font.h"
 #include "video.h"
 #include "log.h"
 #include "ros.h"
 
-static const unsigned char preview[] PROGMEM = {
-    0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0x20,
-    0x20,0x2e,0xa9,0xab,0xaa,0xaa,0xaa,0xab,0x20,0x20,0x20,0x20,0x20,0xa9,0xab,0xaa,0xaa,0xaa,0xab,0x20,0x20,
-    0x20,0x81,0xaa,0xaa,0xae,0x20,0x7f,0xaa,0xaa,0x20,0x20,0x20,0x81,0xaa,0xaa,0xae,0x8c,0x20,0x20,0x20,0x20,
-    0x20,0x80,0xaa,0xaa,0xab,0xab,0xab,0xaa,0xae,0x20,0x20,0x20,0x96,0xaa,0xaa,0xab,0xab,0xab,0x2c,0x20,0x20,
-    0x20,0x7f,0xaa,0xaa,0xaa,0xab,0x20,0x20,0x20,0x20,0x20,0x20,0x20,0xa2,0xae,0xae,0xae,0xaa,0xaa,0x20,0x20,
-    0x20,0x9d,0xaa,0xaa,0x60,0xae,0x81,0xa5,0xab,0xaa,0xaa,0xaa,0xab,0x20,0x20,0x20,0x7f,0xaa,0xaa,0x20,0x20,
-    0x20,0x97,0x81,0xaa,0x20,0x92,0x7f,0xaa,0xaa,0xae,0x20,0x7f,0xaa,0xaa,0x80,0xab,0xaa,0xaa,0xaa,0x20,0x20,
-    0x20,0x8f,0x80,0xae,0x20,0x20,0x9b,0xaa,0xaa,0x20,0x20,0x29,0xaa,0xaa,0x9c,0xae,0xae,0xae,0x60,0x20,0x20,
-    0x20,0x20,0x60,0x20,0x20,0x20,0x92,0xaa,0xaa,0xab,0x2c,0xa9,0xaa,0xaa,0x20,0x20,0x20,0x20,0x20,0x20,0x20,
-    0x20,0x20,0x20,0x20,0x20,0x20,0x27,0x8f,0xae,0xaa,0xaa,0xaa,0xae,0x60,0x20,0x20,0x20,0x20,0x20,0x20,0x20,
-    0x00
+/* tools/rlegen output */
+static const uint8_t preview[] PROGMEM = {
+    RLE_RUN | 22, 0x20,
+    3, 0x2e, 0xa9, 0xab,
+    RLE_RUN | 3, 0xaa,
+    1, 0xab,
+    RLE_RUN | 5, 0x20,
+    2, 0xa9, 0xab,
+    RLE_RUN | 3, 0xaa,
+    1, 0xab,
+    RLE_RUN | 3, 0x20,
+    8, 0x81, 0xaa, 0xaa, 0xae, 0x20, 0x7f, 0xaa, 0xaa,
+    RLE_RUN | 3, 0x20,
+    5, 0x81, 0xaa, 0xaa, 0xae, 0x8c,
+    RLE_RUN | 5, 0x20,
+    3, 0x80, 0xaa, 0xaa,
+    RLE_RUN | 3, 0xab,
+    2, 0xaa, 0xae,
+    RLE_RUN | 3, 0x20,
+    3, 0x96, 0xaa, 0xaa,
+    RLE_RUN | 3, 0xab,
+    1, 0x2c,
+    RLE_RUN | 3, 0x20,
+    1, 0x7f,
+    RLE_RUN | 3, 0xaa,
+    1, 0xab,
+    RLE_RUN | 7, 0x20,
+    1, 0xa2,
+    RLE_RUN | 3, 0xae,
+    2, 0xaa, 0xaa,
+    RLE_RUN | 3, 0x20,
+    8, 0x9d, 0xaa, 0xaa, 0x60, 0xae, 0x81, 0xa5, 0xab,
+    RLE_RUN | 3, 0xaa,
+    1, 0xab,
+    RLE_RUN | 3, 0x20,
+    3, 0x7f, 0xaa, 0xaa,
+    RLE_RUN | 3, 0x20,
+    15, 0x97, 0x81, 0xaa, 0x20, 0x92, 0x7f, 0xaa, 0xaa, 0xae, 0x20, 0x7f, 0xaa, 0xaa, 0x80, 0xab,
+    RLE_RUN | 3, 0xaa,
+    RLE_RUN | 3, 0x20,
+    14, 0x8f, 0x80, 0xae, 0x20, 0x20, 0x9b, 0xaa, 0xaa, 0x20, 0x20, 0x29, 0xaa, 0xaa, 0x9c,
+    RLE_RUN | 3, 0xae,
+    1, 0x60,
+    RLE_RUN | 4, 0x20,
+    1, 0x60,
+    RLE_RUN | 3, 0x20,
+    8, 0x92, 0xaa, 0xaa, 0xab, 0x2c, 0xa9, 0xaa, 0xaa,
+    RLE_RUN | 13, 0x20,
+    3, 0x27, 0x8f, 0xae,
+    RLE_RUN | 3, 0xaa,
+    2, 0xae, 0x60,
+    RLE_RUN | 7, 0x20,
+    RLE_END
 };
 
 #define WELCOME_LEN     12u
@@ -44,22 +95,49 @@ void __callback welcome_flash(bool flag) {
 void ros_bootup(void) {
     /* from ros.c */
     extern void keyboard_input(enum Virtual_Key);
+    extern void console_input(char);
+    /* from fscmd.c */
+    extern bool fs_bootup(void);
 
-    /* Drivers */
+    /* Bottom halves for driver interrupts */
+    defer_init();
+    memstat_init();
+    log_init();
+    prof_init();
+
+    /* Scheduler tick first: panel waits and time-to-prompt are counted in it */
+    ros_graphic_timer_init();
+
+    /* Drivers, panel init stream continues between them */
     spi_device_init();
     st7735_init();
+    const bool spiram = spiram_init();
+    xram_init(spiram ? SPIRAM_SIZE : 0);
+    st7735_poll();
     keyboard_init(keyboard_input);
+    twi_init();
+    uart_init(console_input);
     idle_key = INVALID_KEY;
+    history_init();
+    st7735_poll();
+    config_init();
+    st7735_poll();
+    const bool fs = fs_bootup();
+    st7735_wait();
 
     /* Screen */
     clear_screen(0x0000);
-    ros_puts_P(ATTRIBUTE_DEFAULT, preview, true);
+    ros_puts_rle_P(preview, true);
     ros_flash(welcome_flash);
     ros_putchar(ATTRIBUTE_DEFAULT, '\n');
 
     /* Test log system */
-    ros_graphic_timer_init();
+    if (!spiram)
+        ros_log(LOG_TYPE_WARNING, "No SPI SRAM");
+    if (!fs)
+        ros_log(LOG_TYPE_WARNING, "No filesystem");
     ros_log(LOG_TYPE_INFO, "What a beautiful system.");
+    ros_log(LOG_TYPE_INFO, "Up in %d ms", (int)(sched_now() * SCHED_TICK_MS));
 
     /* Cursor & prompt */
     ros_put_prompt();
@@ -73,5 +151,5 @@ void ros_bootup(void) {
 
 int main(void){
     ros_bootup();
-    for(;;){}
+    sched_run();
 }
\ No newline at end of file
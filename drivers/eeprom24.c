@@ -0,0 +1,87 @@
+#include <inttypes.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "eeprom24.h"
+#include "twi.h"
+#include "fs.h"
+
+/* Plain TWI client, builds on host against tools/twi_sim.c */
+
+static int eeprom24_submit(struct TWI_Transaction *t) {
+    while (!twi_submit(t))
+        ;
+
+    return 0;
+}
+
+/* Whole range is one sequential read, internal address counter rolls over pages */
+int eeprom24_read(uint16_t addr, void *buf, uint16_t len) {
+    const uint8_t header[2] = { (uint8_t)(addr >> 8), (uint8_t)addr };
+    struct TWI_Transaction t = {
+        .address = EEPROM24_ADDRESS,
+        .flags = TWI_FLAG_ACK_POLL,
+        .header = header, .header_len = sizeof(header),
+        .rx = buf, .rx_len = len
+    };
+
+    if ((uint32_t)addr + len > EEPROM24_SIZE)
+        return -1;
+
+    if (!len)
+        return 0;
+
+    eeprom24_submit(&t);
+    return (twi_wait(&t) < 0) ? -1 : (int)len;
+}
+
+/* Page writes are queued back to back, ACK polling of each next page waits out the write cycle */
+int eeprom24_write(uint16_t addr, const void *buf, uint16_t len) {
+    struct TWI_Transaction pages[EEPROM24_WINDOW];
+    uint8_t headers[EEPROM24_WINDOW][2];
+    const uint8_t *src = buf;
+    uint8_t n = 0;
+    int res = (int)len;
+
+    if ((uint32_t)addr + len > EEPROM24_SIZE)
+        return -1;
+
+    while (len > 0) {
+        const uint8_t slot = n % EEPROM24_WINDOW;
+        uint16_t chunk = EEPROM24_PAGE_SIZE - (addr % EEPROM24_PAGE_SIZE);
+
+        if (chunk > len)
+            chunk = len;
+
+        if ((n >= EEPROM24_WINDOW) && (twi_wait(&pages[slot]) < 0))
+            res = -1;
+
+        headers[slot][0] = (uint8_t)(addr >> 8);
+        headers[slot][1] = (uint8_t)addr;
+        pages[slot] = (struct TWI_Transaction){
+            .address = EEPROM24_ADDRESS,
+            .flags = TWI_FLAG_ACK_POLL,
+            .header = headers[slot], .header_len = 2,
+            .tx = src, .tx_len = chunk
+        };
+        eeprom24_submit(&pages[slot]);
+
+        addr += chunk;
+        src += chunk;
+        len -= chunk;
+        n ++;
+    }
+
+    /* Transactions live on this stack frame, so all of them must finish here */
+    for (uint8_t i = (n > EEPROM24_WINDOW) ? n - EEPROM24_WINDOW : 0; i < n; i++)
+        if (twi_wait(&pages[i % EEPROM24_WINDOW]) < 0)
+            res = -1;
+
+    return res;
+}
+
+const struct FS_Device eeprom24_device = {
+    .read = eeprom24_read,
+    .write = eeprom24_write,
+    .pages = (uint16_t)(EEPROM24_SIZE / EEPROM24_PAGE_SIZE)
+};
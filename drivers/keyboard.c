@@ -9,17 +9,15 @@
 #include "video.h"
 #include "spi.h"
 #include "keyboard.h"
+#include "defer.h"
+#include "memstat.h"
+#include "trace.h"
+#include "prof.h"
 #include "log.h"
 #include "ros.h"
 
-#ifndef NDEBUG
-    /* Speed-up emulator */
-    #define KEYBOARD_DELAY_MS       0
-#else
-    #define KEYBOARD_DELAY_MS       100
-#endif
-
 static volatile Keyboard_User_Callback input_keyboard_callback = NULL;
+static volatile uint8_t keyboard_delay_ms = KEYBOARD_DELAY_MS;
 
 /* Lookup table for optimization. */
 /* Structured as pairs of characters ( without and with SHIFT/CAPS mode ) */
@@ -49,6 +47,7 @@ static const Keyboard_Nonprintable_Callback keyboard_nonprintable_callbacks[0xA]
 };
 
 volatile enum Virtual_Key idle_key = INVALID_KEY;
+static volatile bool idle_latch = false;
 
 int vk_as_char(enum Virtual_Key key) {
     uint16_t kdata = pgm_read_word(&char_decode_table[key * 2]);
@@ -77,19 +76,28 @@ void __driver keyboard_init(Keyboard_User_Callback input_callback) {
     sei();
 }
 
-ISR(INT0_vect) {
-    while (!(SPI->rSPSR & BIT(SPIF))) /* Wait for spi transaction to complete */
-        ;
+/* Delay comes from config store, so it can't be a _delay_ms() constant */
+static void keyboard_pulse(uint8_t pin) {
+    BIT_OFF(PORTC, pin);
+    for (uint8_t i = 0; i < keyboard_delay_ms; i++)
+        _delay_ms(1);
 
-    if (sys_mode == SYSTEM_MODE_BUSY)
-        return;
+    BIT_ON(PORTC, pin);
+    for (uint8_t i = 0; i < keyboard_delay_ms; i++)
+        _delay_ms(1);
+}
 
-    ROS_TOGGLE_PIN(C, KEYBOARD_SHLD_PIN, KEYBOARD_DELAY_MS);
+void keyboard_set_delay(uint8_t ms) {
+    keyboard_delay_ms = ms;
+}
 
+static enum Virtual_Key keyboard_scan(void) {
     uint64_t keyboard_shot = 0;
+
+    PROF_BEGIN(kbd_scan);
     for (int i = 0; i < 58; i++) {
         keyboard_shot = (keyboard_shot << 1) | ((~BIT_EXT(PINC, KEYBOARD_SO_PIN)) & 1);
-        ROS_TOGGLE_PIN(C, KEYBOARD_CLK_PIN, KEYBOARD_DELAY_MS);
+        keyboard_pulse(KEYBOARD_CLK_PIN);
     }
 
     int idx = 0;
@@ -100,14 +108,60 @@ ISR(INT0_vect) {
     if ((idx - 1) >= 58)
         HARD_ERROR(FAULT_DRIVER_KEYBOARD);
 
-    switch (sys_mode) {
-    case SYSTEM_MODE_INPUT:
-        if (input_keyboard_callback) input_keyboard_callback(idx - 1);
-        break;
+    PROF_END(kbd_scan);
+    return (enum Virtual_Key)(idx - 1);
+}
 
-    case SYSTEM_MODE_IDLE:
-        idle_key = (enum Virtual_Key)(idx - 1);
-        sys_mode = SYSTEM_MODE_BUSY;
-        break;
+/* Latch key state into 74hc165 and shift it out. Pulses take 2 * keyboard_delay_ms each,
+   so this only ever runs in task context */
+static enum Virtual_Key keyboard_read(void) {
+    keyboard_pulse(KEYBOARD_SHLD_PIN);
+    const enum Virtual_Key vk = keyboard_scan();
+
+    EIMSK |= BIT(INT0);
+    TRACE_EVENT(KEY, vk);
+    return vk;
+}
+
+/* Bottom half: read keys and run callbacks in task context */
+static void __callback keyboard_work(uint8_t arg) {
+    (void) arg;
+
+    const enum Virtual_Key vk = keyboard_read();
+
+    if ((sys_mode == SYSTEM_MODE_INPUT) && input_keyboard_callback)
+        input_keyboard_callback(vk);
+}
+
+/* Called by the task spinning on idle_key: in SYSTEM_MODE_IDLE defer queue is not served */
+void keyboard_idle_poll(void) {
+    if (!idle_latch)
+        return;
+
+    idle_latch = false;
+    idle_key = keyboard_read();
+}
+
+/* Only hands the key off, so INT0 latency does not depend on keyboard_delay_ms */
+ISR(INT0_vect) {
+    IRQ_MEASURE_BEGIN();
+    MEMSTAT_ISR_ENTER(MEMSTAT_ISR_INT0);
+    TRACE_EVENT(INT0_ENTER, sys_mode);
+
+    if (sys_mode == SYSTEM_MODE_BUSY) {
+        TRACE_EVENT(INT0_EXIT, 0);
+        return;
     }
+
+    /* No new edge until keys are read. With the queue full this key is lost, but the next one is not */
+    EIMSK &= ~BIT(INT0);
+
+    if (sys_mode == SYSTEM_MODE_IDLE) {
+        idle_latch = true;
+        sys_mode = SYSTEM_MODE_BUSY;
+    } else if (!defer(keyboard_work, 0))
+        EIMSK |= BIT(INT0);
+
+    TRACE_EVENT(INT0_EXIT, 0);
+    IRQ_MEASURE_END(IRQ_PROBE_INT0);
 }
\ No newline at end of file
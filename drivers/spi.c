@@ -29,6 +29,11 @@ void __driver spi_device_init(void) {
     ROS_SET_PIN_DIRECTION(B, SPI_MOSI_PIN, PIN_DIRECTION_OUTPUT);
     ROS_SET_PIN_DIRECTION(B, SPI_SCK_PIN, PIN_DIRECTION_OUTPUT);
     ROS_SET_PIN_DIRECTION(B, SPI_SS_PIN, PIN_DIRECTION_OUTPUT);
+    ROS_SET_PIN_DIRECTION(B, SPI_MISO_PIN, PIN_DIRECTION_INPUT);
+
+    /* Other slaves stay deselected until spi_device_select() */
+    ROS_SET_PIN_DIRECTION(B, SPI_SRAM_CS_PIN, PIN_DIRECTION_OUTPUT);
+    BIT_ON(PORTB, SPI_SRAM_CS_PIN);
 
     SPI->rSPCR = SPI_SPR;             /* MSB mode & SCK frequency */
     SPI->rSPCR |= BIT(MSTR);          /* Set master mode */
@@ -55,4 +60,27 @@ void __driver spi_device_transfer_buffer(const uint8_t *buffer, unsigned short b
 
     while (buffer_size-- > 0)
         spi_device_transfer_byte(*buffer++);
+}
+
+uint8_t __driver spi_device_exchange_byte(const uint8_t ch) {
+    spi_device_transfer_byte(ch);
+    return SPI->rSPDR;
+}
+
+/* Bus users all run in task context, so arbitration is just CS & mode switching */
+void __driver spi_device_select(enum SPI_Slave slave) {
+    if (slave == SPI_SLAVE_DISPLAY) {
+        spi_device_release();
+        return;
+    }
+
+    BIT_ON(PORTB, SPI_DISPLAY_CS_PIN);
+    BIT_OFF(SPI->rSPCR, CPHA);
+    BIT_OFF(PORTB, SPI_SRAM_CS_PIN);
+}
+
+void __driver spi_device_release(void) {
+    BIT_ON(PORTB, SPI_SRAM_CS_PIN);
+    BIT_ON(SPI->rSPCR, CPHA);
+    BIT_OFF(PORTB, SPI_DISPLAY_CS_PIN);
 }
\ No newline at end of file
@@ -0,0 +1,55 @@
+#include <inttypes.h>
+#include <stdbool.h>
+
+#include <avr/io.h>
+
+#include "ros.h"
+#include "spi.h"
+#include "spiram.h"
+
+static void spiram_begin(uint8_t cmd, uint16_t addr) {
+    spi_device_select(SPI_SLAVE_SRAM);
+    spi_device_transfer_byte(cmd);
+    spi_device_transfer_byte((uint8_t)(addr >> 8));
+    spi_device_transfer_byte((uint8_t)addr);
+}
+
+/* Returns false, when there is no chip answering on the bus */
+bool __driver spiram_init(void) {
+    static const uint8_t probe[2] = { 0x5A, 0xA5 };
+    uint8_t mode, check[2];
+
+    spi_device_select(SPI_SLAVE_SRAM);
+    spi_device_transfer_byte(SPIRAM_CMD_WRMR);
+    spi_device_transfer_byte(SPIRAM_MODE_SEQUENTIAL);
+    spi_device_release();
+
+    spi_device_select(SPI_SLAVE_SRAM);
+    spi_device_transfer_byte(SPIRAM_CMD_RDMR);
+    mode = spi_device_exchange_byte(0xFF);
+    spi_device_release();
+
+    if (mode != SPIRAM_MODE_SEQUENTIAL)
+        return false;
+
+    spiram_write(0, probe, sizeof(probe));
+    spiram_read(0, check, sizeof(check));
+    return (check[0] == probe[0]) && (check[1] == probe[1]);
+}
+
+/* Whole range is one burst: command + address once, then a byte per 2 SCK cycles x 8 */
+void __driver spiram_read(uint16_t addr, void *buf, uint16_t len) {
+    uint8_t *dst = buf;
+
+    spiram_begin(SPIRAM_CMD_READ, addr);
+    while (len-- > 0)
+        *dst++ = spi_device_exchange_byte(0xFF);
+
+    spi_device_release();
+}
+
+void __driver spiram_write(uint16_t addr, const void *buf, uint16_t len) {
+    spiram_begin(SPIRAM_CMD_WRITE, addr);
+    spi_device_transfer_buffer(buf, len);
+    spi_device_release();
+}
@@ -1,40 +1,55 @@
-#include <util/delay.h>
-#include <avr/interrupt.h>
+#include <stdbool.h>
 #include <avr/io.h>
 #include <avr/pgmspace.h>
 
 #include "ros.h"
+#include "sched.h"
 #include "spi.h"
 #include "st7735.h"
-
-static const struct ST7735_Command startup[] PROGMEM = {
-    { ST7735_SWRESET, 0, { 0 }, 150 },
-    { ST7735_SLPOUT, 0, { 0 }, 255 },
-    { ST7735_FRMCTR1, 3, { 0x01, 0x2C, 0x2D }, 0 },
-    { ST7735_FRMCTR2, 3, { 0x01, 0x2C, 0x2D }, 0 },
-    { ST7735_FRMCTR3, 6, { 0x01, 0x2C, 0x2D,  0x01, 0x2C, 0x2D }, 0 },
-    { ST7735_INVCTR, 1, { 0x07 }, 0 },
-    { ST7735_PWCTR1, 3, { 0xA2, 0x02, 0x84 }, 0 },
-    { ST7735_PWCTR2, 1, { 0xC5 }, 0 },
-    { ST7735_PWCTR3, 2, { 0x0A, 0x00 }, 0 },
-    { ST7735_PWCTR4, 2, { 0x8A, 0x2A }, 0 },
-    { ST7735_PWCTR5, 2, { 0x8A, 0xEE }, 0 },
-    { ST7735_VMCTR1, 1, { 0x0E }, 0 },
-    { ST7735_INVOFF, 0, { 0 }, 0 },
-    { ST7735_COLMOD, 1, { 0x05 }, 0 },
-
-    { ST7735_GMCTRP1, 16, { 0x02, 0x1c, 0x07, 0x12, 0x37, 0x32, 0x29, 0x2d, 0x29, 0x25, 0x2B, 0x39, 0x00, 0x01, 0x03, 0x10 }, 0 },
-    { ST7735_GMCTRN1, 16, { 0x03, 0x1d, 0x07, 0x06, 0x2E, 0x2C, 0x29, 0x2D, 0x2E, 0x2E, 0x37, 0x3F, 0x00, 0x00, 0x02, 0x10 }, 0 },
-    { ST7735_NORON, 0, { 0 }, 10 },
-    { ST7735_DISPON, 0, { 0 }, 100 },
-
-    { ST7735_MADCTL, 1, { 0 }, 0 },
-
-    { ST7735_CASET, 4, { 0, 0, 0, SCREEN_WIDTH }, 0 },
-    { ST7735_RASET, 4, { 0, 0, 0, SCREEN_HEIGHT }, 0 },
-    { ST7735_RAMWR, 0, { 0 }, 150 }
+#include "trace.h"
+
+/* Init stream: command, argument count ( ORed with STREAM_WAIT when a wait follows ),
+   arguments, then wait in scheduler ticks */
+#define STREAM_WAIT         0x80
+#define MS_TO_TICKS(ms)     (((ms) + SCHED_TICK_MS - 1) / SCHED_TICK_MS)
+
+static const uint8_t startup[] PROGMEM = {
+    ST7735_SWRESET, STREAM_WAIT, MS_TO_TICKS(150),
+    ST7735_SLPOUT, STREAM_WAIT, MS_TO_TICKS(500),
+    ST7735_FRMCTR1, 3, 0x01, 0x2C, 0x2D,
+    ST7735_FRMCTR2, 3, 0x01, 0x2C, 0x2D,
+    ST7735_FRMCTR3, 6, 0x01, 0x2C, 0x2D,  0x01, 0x2C, 0x2D,
+    ST7735_INVCTR, 1, 0x07,
+    ST7735_PWCTR1, 3, 0xA2, 0x02, 0x84,
+    ST7735_PWCTR2, 1, 0xC5,
+    ST7735_PWCTR3, 2, 0x0A, 0x00,
+    ST7735_PWCTR4, 2, 0x8A, 0x2A,
+    ST7735_PWCTR5, 2, 0x8A, 0xEE,
+    ST7735_VMCTR1, 1, 0x0E,
+    ST7735_INVOFF, 0,
+    ST7735_COLMOD, 1, 0x05,
+
+    ST7735_GMCTRP1, 16, 0x02, 0x1c, 0x07, 0x12, 0x37, 0x32, 0x29, 0x2d, 0x29, 0x25, 0x2B, 0x39, 0x00, 0x01, 0x03, 0x10,
+    ST7735_GMCTRN1, 16, 0x03, 0x1d, 0x07, 0x06, 0x2E, 0x2C, 0x29, 0x2D, 0x2E, 0x2E, 0x37, 0x3F, 0x00, 0x00, 0x02, 0x10,
+    ST7735_NORON, STREAM_WAIT, MS_TO_TICKS(10),
+    ST7735_DISPON, STREAM_WAIT, MS_TO_TICKS(100),
+
+    ST7735_MADCTL, 1, 0,
+
+    ST7735_CASET, 4, 0, 0, 0, SCREEN_WIDTH,
+    ST7735_RASET, 4, 0, 0, 0, SCREEN_HEIGHT,
+    ST7735_RAMWR, STREAM_WAIT, MS_TO_TICKS(150)
 };
 
+static struct {
+    uint8_t offset;             /* Next command in startup[] */
+    uint8_t wait;               /* Ticks, 0 if none */
+    uint16_t since;
+    bool done;
+} init = { 0 };
+
+static_assert( sizeof(startup) <= UINT8_MAX );
+
 static void st7735_send_command(const ST7735_Command command){
     BIT_OFF(PORTB, ST7735_DC_PIN);
     BIT_OFF(PORTB, SPI_SS_PIN);
@@ -46,32 +61,70 @@ static void st7735_send_command(const ST7735_Command command){
         spi_device_transfer_buffer(command.args, command.nargs);
         BIT_OFF(PORTB, ST7735_DC_PIN);
     }
+}
 
-    if (!command.delay_after) return;
-    int delay = (command.delay_after == 0xFF) ? 500 : (int)command.delay_after;
+/* Sends one stream command, returns offset of the next one */
+static uint8_t st7735_send_stream(uint8_t offset){
+    const uint8_t type = pgm_read_byte(&startup[offset ++]);
+    const uint8_t count = pgm_read_byte(&startup[offset ++]);
 
-    for (int i = 0; i < delay; ++i)
-        _delay_ms(1);
-}
+    BIT_OFF(PORTB, ST7735_DC_PIN);
+    BIT_OFF(PORTB, SPI_SS_PIN);
 
-static ST7735_Command pgm_read_st7735_command(const void *mem)
-{
-    ST7735_Command com;
-    memcpy_P(&com, mem, sizeof(com));
-    return com;
+    spi_device_transfer_byte(type);
+
+    if (count & ~STREAM_WAIT){
+        BIT_ON(PORTB, ST7735_DC_PIN);
+        for (uint8_t i = 0; i < (count & ~STREAM_WAIT); i++)
+            spi_device_transfer_byte(pgm_read_byte(&startup[offset ++]));
+        BIT_OFF(PORTB, ST7735_DC_PIN);
+    }
+
+    if (count & STREAM_WAIT){
+        init.wait = pgm_read_byte(&startup[offset ++]);
+        init.since = sched_now();
+    }
+
+    return offset;
 }
 
+/* Starts init stream, it is continued by st7735_poll() once panel waits run out,
+   so other drivers come up meanwhile. Needs scheduler tick running */
 void __driver st7735_init(void){
-    cli();
-
     ROS_SET_PIN_DIRECTION(B, ST7735_DC_PIN, PIN_DIRECTION_OUTPUT);
 
-    for (unsigned i = 0; i < sizeof(startup) / sizeof(startup[0]); ++i)
-        st7735_send_command(pgm_read_st7735_command(&startup[i]));
-    
+    init.offset = 0;
+    init.wait = 0;
+    init.done = false;
+    st7735_poll();
+}
+
+/* Sends commands up to next unexpired wait. Returns true once panel is ready */
+bool __driver st7735_poll(void){
+    if (init.done)
+        return true;
+
+    for (;;) {
+        /* Elapsed ticks must exceed wait: current tick is partly gone */
+        if (init.wait && ((uint16_t)(sched_now() - init.since) <= init.wait))
+            return false;
+        init.wait = 0;
+
+        if (init.offset >= sizeof(startup))
+            break;
+
+        init.offset = st7735_send_stream(init.offset);
+    }
+
     BIT_OFF(PORTB, SPI_SS_PIN);
     BIT_ON(PORTB, ST7735_DC_PIN);
-    sei();
+    init.done = true;
+    return true;
+}
+
+void __driver st7735_wait(void){
+    while (!st7735_poll())
+        ;
 }
 
 void __driver st7735_set_window(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2){
@@ -80,9 +133,10 @@ void __driver st7735_set_window(uint8_t x1, uint8_t y1, uint8_t x2, uint8_t y2){
     if (x2 > SCREEN_WIDTH + 1) x2 = SCREEN_WIDTH + 1;
     if (y2 > SCREEN_HEIGHT + 1) y2 = SCREEN_HEIGHT + 1;
 
-    st7735_send_command((struct ST7735_Command){ ST7735_CASET, 4, { 0, x1, 0, x2 }, 0 });
-    st7735_send_command((struct ST7735_Command){ ST7735_RASET, 4, { 0, y1, 0, y2 }, 0 });
-    st7735_send_command((struct ST7735_Command){ ST7735_RAMWR, 0, { 0 }, 0 });
+    TRACE_EVENT(SET_WINDOW, y1);
+    st7735_send_command((struct ST7735_Command){ ST7735_CASET, 4, { 0, x1, 0, x2 } });
+    st7735_send_command((struct ST7735_Command){ ST7735_RASET, 4, { 0, y1, 0, y2 } });
+    st7735_send_command((struct ST7735_Command){ ST7735_RAMWR, 0, { 0 } });
 }
 
 void __driver st7735_freeze(void){
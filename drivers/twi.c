@@ -0,0 +1,161 @@
+#include <inttypes.h>
+#include <stdbool.h>
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <util/atomic.h>
+#include <util/twi.h>
+
+#include "ros.h"
+#include "twi.h"
+#include "memstat.h"
+#include "trace.h"
+#include "prof.h"
+
+#define TWI_BITRATE     (uint8_t)(((F_CPU / TWI_FREQUENCY) - 16) / 2)
+
+#define TWCR_START      (BIT(TWINT) | BIT(TWSTA) | BIT(TWEN) | BIT(TWIE))
+#define TWCR_RESTART    (BIT(TWINT) | BIT(TWSTO) | BIT(TWSTA) | BIT(TWEN) | BIT(TWIE))
+#define TWCR_STOP       (BIT(TWINT) | BIT(TWSTO) | BIT(TWEN))
+#define TWCR_NACK       (BIT(TWINT) | BIT(TWEN) | BIT(TWIE))
+#define TWCR_ACK        (TWCR_NACK | BIT(TWEA))
+
+static struct TWI_Transaction *queue[TWI_QUEUE_CAP] = { 0 };
+static volatile uint8_t queue_head = 0, queue_tail = 0;
+
+static struct TWI_Transaction *volatile current = NULL;
+static uint16_t pos = 0, retries = 0;
+static bool reading = false;
+
+void __driver twi_init(void) {
+    cli();
+    ROS_SET_PIN_DIRECTION(C, TWI_SDA_PIN, PIN_DIRECTION_INPUT_PULLUP);
+    ROS_SET_PIN_DIRECTION(C, TWI_SCL_PIN, PIN_DIRECTION_INPUT_PULLUP);
+
+    TWSR = 0;                   /* Prescaler 1 */
+    TWBR = TWI_BITRATE;         /* SCL = F_CPU / (16 + 2 * TWBR) */
+    TWCR = BIT(TWEN);
+    sei();
+}
+
+/* Called with interrupts disabled, STOP of finished transaction is merged with next START */
+static void twi_start_next(bool after_stop) {
+    if (queue_tail == queue_head) {
+        current = NULL;
+        if (after_stop)
+            TWCR = TWCR_STOP;
+        return;
+    }
+
+    current = queue[queue_tail];
+    queue_tail = (queue_tail + 1) & (TWI_QUEUE_CAP - 1);
+
+    pos = retries = 0;
+    reading = false;
+    TWCR = after_stop ? TWCR_RESTART : TWCR_START;
+}
+
+static inline void twi_finish(uint8_t status) {
+    current->status = status;
+    twi_start_next(true);
+}
+
+bool twi_submit(struct TWI_Transaction *t) {
+    bool queued = false;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        const uint8_t next = (queue_head + 1) & (TWI_QUEUE_CAP - 1);
+
+        if (next != queue_tail) {
+            t->status = TWI_STATUS_PENDING;
+            queue[queue_head] = t;
+            queue_head = next;
+            queued = true;
+
+            if (!current)
+                twi_start_next(false);
+        }
+    }
+
+    return queued;
+}
+
+int twi_wait(struct TWI_Transaction *t) {
+    while (t->status == TWI_STATUS_PENDING)
+        ;
+
+    return (t->status == TWI_STATUS_DONE) ? 0 : -1;
+}
+
+ISR(TWI_vect) {
+    struct TWI_Transaction *t = current;
+
+    PROF_BEGIN(twi_isr);
+    MEMSTAT_ISR_ENTER(MEMSTAT_ISR_TWI);
+    TRACE_EVENT(TWI_ENTER, TW_STATUS);
+
+    switch (TW_STATUS) {
+    case TW_START:
+    case TW_REP_START:
+        TWDR = (uint8_t)((t->address << 1) | reading);
+        TWCR = TWCR_NACK;
+        break;
+
+    case TW_MT_SLA_ACK:
+    case TW_MT_DATA_ACK:
+        if (pos < t->header_len + t->tx_len) {
+            TWDR = (pos < t->header_len) ? t->header[pos] : t->tx[pos - t->header_len];
+            pos ++;
+            TWCR = TWCR_NACK;
+            break;
+        }
+
+        if (t->rx_len) {
+            reading = true;
+            pos = 0;
+            TWCR = TWCR_START;
+            break;
+        }
+
+        twi_finish(TWI_STATUS_DONE);
+        break;
+
+    case TW_MT_SLA_NACK:
+    case TW_MR_SLA_NACK:
+        /* ACK polling: slave is busy with internal write cycle */
+        if ((t->flags & TWI_FLAG_ACK_POLL) && (retries ++ < TWI_POLL_LIMIT)) {
+            pos = 0;
+            reading = false;
+            TWCR = TWCR_RESTART;
+            break;
+        }
+
+        twi_finish(TWI_STATUS_NACK);
+        break;
+
+    case TW_MR_SLA_ACK:
+        TWCR = (t->rx_len > 1) ? TWCR_ACK : TWCR_NACK;
+        break;
+
+    case TW_MR_DATA_ACK:
+        t->rx[pos ++] = TWDR;
+        TWCR = (pos + 1 < t->rx_len) ? TWCR_ACK : TWCR_NACK;
+        break;
+
+    case TW_MR_DATA_NACK:
+        t->rx[pos ++] = TWDR;
+        twi_finish(TWI_STATUS_DONE);
+        break;
+
+    case TW_MT_ARB_LOST:
+        TWCR = TWCR_START;
+        break;
+
+    default:
+        twi_finish(TWI_STATUS_ERROR);
+        break;
+    }
+
+    TRACE_EVENT(TWI_EXIT, 0);
+    PROF_END(twi_isr);
+}
@@ -0,0 +1,170 @@
+#include <inttypes.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <util/atomic.h>
+
+#include "ros.h"
+#include "uart.h"
+#include "defer.h"
+#include "keyboard.h"
+#include "video.h"
+#include "shell.h"
+#include "log.h"
+
+static_assert( (UART_TX_CAP & (UART_TX_CAP - 1)) == 0 );
+static_assert( (UART_RX_CAP & (UART_RX_CAP - 1)) == 0 );
+
+static uint8_t tx_ring[UART_TX_CAP], rx_ring[UART_RX_CAP];
+static volatile uint8_t tx_head = 0, tx_tail = 0;
+static volatile uint8_t rx_head = 0, rx_tail = 0;
+static volatile bool rx_pending = false;
+
+static volatile struct Uart_Stats stats = { 0 };
+static volatile Uart_Input_Callback input_callback = NULL;
+
+bool uart_mirror_enabled = true;
+
+/* 8N1, both directions interrupt driven */
+void __driver uart_init(Uart_Input_Callback callback) {
+    input_callback = callback;
+
+    UBRR0 = UART_UBRR;
+    UCSR0A = BIT(U2X0);
+    UCSR0C = BIT(UCSZ01) | BIT(UCSZ00);
+    UCSR0B = BIT(TXEN0) | BIT(RXEN0) | BIT(RXCIE0);
+}
+
+/* Waits for ring space, unless called with interrupts disabled */
+void __driver uart_putc(uint8_t c) {
+    const uint8_t next = (tx_head + 1) & (UART_TX_CAP - 1);
+
+    while (next == tx_tail) {
+        if (!(SREG & BIT(SREG_I))) {
+            stats.tx_drops ++;
+            return;
+        }
+    }
+
+    tx_ring[tx_head] = c;
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        tx_head = next;
+        stats.tx ++;
+        UCSR0B |= BIT(UDRIE0);
+    }
+}
+
+void __driver uart_write(const void *buf, uint16_t len) {
+    const uint8_t *p = buf;
+
+    while (len--)
+        uart_putc(*p++);
+}
+
+/* Screen output copy for a host terminal, newlines become CR LF */
+void __driver uart_mirror(uint8_t c) {
+    if (!uart_mirror_enabled)
+        return;
+
+    if (c == '\n')
+        uart_putc('\r');
+    uart_putc(c);
+}
+
+/* Non-blocking, -1 when ring is empty */
+int __driver uart_getc(void) {
+    uint8_t c;
+
+    if (rx_tail == rx_head)
+        return -1;
+
+    c = rx_ring[rx_tail];
+    rx_tail = (rx_tail + 1) & (UART_RX_CAP - 1);
+    return c;
+}
+
+struct Uart_Stats uart_stats(void) {
+    struct Uart_Stats s;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+        s = stats;
+
+    return s;
+}
+
+/* Line editor only accepts input in SYSTEM_MODE_INPUT, the rest waits in ring ( or for uart_getc() ) */
+static void __callback uart_input_work(uint8_t arg) {
+    int ch;
+
+    (void) arg;
+
+    while ((sys_mode == SYSTEM_MODE_INPUT) && ((ch = uart_getc()) >= 0))
+        if (input_callback)
+            input_callback((char)ch);
+
+    rx_pending = false;
+}
+
+ISR(USART_UDRE_vect) {
+    if (tx_tail == tx_head) {
+        UCSR0B &= ~BIT(UDRIE0);
+        return;
+    }
+
+    UDR0 = tx_ring[tx_tail];
+    tx_tail = (tx_tail + 1) & (UART_TX_CAP - 1);
+}
+
+ISR(USART_RX_vect) {
+    const bool overrun = UCSR0A & BIT(DOR0);
+    const uint8_t c = UDR0;
+    const uint8_t next = (rx_head + 1) & (UART_RX_CAP - 1);
+
+    stats.rx ++;
+    if (overrun)
+        stats.overruns ++;
+
+    /* Waiting for any key, same as keyboard INT0 in SYSTEM_MODE_IDLE. Byte is kept for ros_wait_key() */
+    const bool idle = (sys_mode == SYSTEM_MODE_IDLE);
+    if (idle) {
+        idle_key = VK_SPACE;
+        sys_mode = SYSTEM_MODE_BUSY;
+    }
+
+    if (next == rx_tail) {
+        stats.overruns ++;
+        return;
+    }
+
+    rx_ring[rx_head] = c;
+    rx_head = next;
+
+    if (!idle && !rx_pending)
+        rx_pending = defer(uart_input_work, 0);
+}
+
+int shell_cmd_uart(uint8_t argc, char **argv) {
+    if (argc == 2) {
+        if (!strcmp(argv[1], "on"))
+            uart_mirror_enabled = true;
+        else if (!strcmp(argv[1], "off"))
+            uart_mirror_enabled = false;
+        else {
+            ros_log(LOG_TYPE_ERROR, "Usage: help uart");
+            return -1;
+        }
+
+        return 0;
+    }
+
+    const struct Uart_Stats s = uart_stats();
+
+    ros_printf(ATTRIBUTE_DEFAULT, "mirror\t%s\n", uart_mirror_enabled ? "on" : "off");
+    ros_printf(ATTRIBUTE_DEFAULT, "tx\t%d\n", (int)s.tx);
+    ros_printf(ATTRIBUTE_DEFAULT, "rx\t%d\n", (int)s.rx);
+    ros_printf(ATTRIBUTE_DEFAULT, "overrun\t%d\n", s.overruns);
+    ros_printf(ATTRIBUTE_DEFAULT, "dropped\t%d\n", s.tx_drops);
+    return 0;
+}
@@ -41,7 +41,7 @@ PPM_Image load_ppm_image(const char *path){
     assert( fscanf(f, "P"PPM_VERSION PPM_DELIMITER "%li" PPM_DELIMITER "%li" PPM_DELIMITER "%lu" PPM_DELIMITER, 
             &(ppm_image.width), &(ppm_image.height), &(ppm_image.color_depth)) == 3 );
 
-    printf("Width - %ld\nHeight - %ld\nDepth - %ld\n", ppm_image.width, ppm_image.height, ppm_image.color_depth);
+    fprintf(stderr, "Width - %ld\nHeight - %ld\nDepth - %ld\n", ppm_image.width, ppm_image.height, ppm_image.color_depth);
 
     size_t ppm_size = sizeof(PPM_Color) * ppm_image.width * ppm_image.height;
     ppm_image.colors = malloc(ppm_size);
@@ -59,19 +59,14 @@ void get_ppm_character(const PPM_Image *base, uint32_t px, uint32_t py, PPM_Char
     }
 }
 
-void dump_ppm_character(const PPM_Character ch){
-    printf("{ ");
-    const char *delim = "";
-
-    for (uint32_t py = 0; py < CHARACTER_HEIGHT; py++, delim = ","){
-        uint8_t byte = 0;
+/* Row bytes, LSB is left pixel */
+void ppm_character_rows(const PPM_Character ch, uint8_t rows[CHARACTER_HEIGHT]){
+    for (uint32_t py = 0; py < CHARACTER_HEIGHT; py++){
+        rows[py] = 0;
         for (uint32_t px = 0; px < CHARACTER_WIDTH; px++)
             if (ch[TO1(px,py,CHARACTER_WIDTH)].r > 0)
-                byte |= (1 << px);
-        printf("%s0x%"PRIX8"", delim, byte);
+                rows[py] |= (1 << px);
     }
-
-    printf(" },\n");
 }
 
 void unload_ppm_image(PPM_Image * const pi){
@@ -81,22 +76,204 @@ void unload_ppm_image(PPM_Image * const pi){
     pi->colors = NULL;
 }
 
-int main(int argc, char *argv[]){
-    if (argc < 2){
-        USAGE("%s <filename>", *argv);
+/* Layouts of include/font.h, renderer reads them through font_row() */
+enum Layout {
+    LAYOUT_ROWS = 0,    /* [8] row bytes, LSB is left pixel */
+    LAYOUT_COLUMNS,     /* [6] column bytes, LSB is top pixel */
+    LAYOUT_PACKED,      /* [6] 6-bit rows, row N at bits 6N of little-endian 48-bit glyph */
+    LAYOUT_SHIFTED,     /* [9] row bytes, MSB is left pixel, row 8 is row 7 underlined */
+    LAYOUT_NUMBER
+};
+
+static const struct {
+    const char *name;
+    unsigned bytes;
+} layouts[LAYOUT_NUMBER] = {
+    [LAYOUT_ROWS]    = { "rows",    CHARACTER_HEIGHT },
+    [LAYOUT_COLUMNS] = { "columns", CHARACTER_WIDTH },
+    [LAYOUT_PACKED]  = { "packed",  CHARACTER_WIDTH * CHARACTER_HEIGHT / 8 },
+    [LAYOUT_SHIFTED] = { "shifted", CHARACTER_HEIGHT + 1 },
+};
+
+#define CODES_CAP           256
+#define CONTROL_CODES       0x20    /* Blank */
+#define ASCII_END           0x7F    /* Pseudo graphics begin on next codepage row */
+
+static uint8_t glyphs[CODES_CAP][CHARACTER_HEIGHT];
+static unsigned codes_number = 0;
+
+/* Codepage cells to character codes: ASCII row tail is not used, blank tail is dropped */
+void load_codes(const PPM_Image *pi){
+    const int columns = pi->width / CHARACTER_WIDTH;
+    const int cells = columns * (pi->height / CHARACTER_HEIGHT);
+    const int ascii_cells = ASCII_END - CONTROL_CODES;
+    const int graphics_cell = (ascii_cells + columns - 1) / columns * columns;
+
+    codes_number = CONTROL_CODES;
+
+    for (int cell = 0; (cell < cells) && (codes_number < CODES_CAP); cell++){
+        if ((cell >= ascii_cells) && (cell < graphics_cell))
+            continue;
+
+        PPM_Character ch = { 0 };
+        get_ppm_character(pi, (cell % columns) * CHARACTER_WIDTH, (cell / columns) * CHARACTER_HEIGHT, ch);
+        ppm_character_rows(ch, glyphs[codes_number ++]);
+    }
+
+    while (codes_number > CONTROL_CODES){
+        static const uint8_t blank[CHARACTER_HEIGHT] = { 0 };
+
+        if (memcmp(glyphs[codes_number - 1], blank, sizeof(blank)))
+            break;
+        codes_number --;
+    }
+}
+
+static int hex_digit(int c){
+    if ((c >= '0') && (c <= '9')) return c - '0';
+    if ((c >= 'a') && (c <= 'f')) return c - 'a' + 10;
+    if ((c >= 'A') && (c <= 'F')) return c - 'A' + 10;
+    return -1;
+}
+
+/* ASCII is always kept, console input may be any of it. From files come raw bytes
+   and '0xNN' / '\xNN' literals, so sources keep their strings and PROGMEM screens */
+void subset_scan(const char *path, uint8_t *keep){
+    FILE *f = fopen(path, "rb");
+
+    if (!f){
+        perror(path);
         exit(EXIT_FAILURE);
     }
 
-    PPM_Image pi = load_ppm_image(argv[1]);
-    
-    for (int j = 0; j < pi.height / CHARACTER_HEIGHT; j++){
-        for (int i = 0; i < pi.width / CHARACTER_WIDTH; i++){
-            PPM_Character ch = { 0 };
-            get_ppm_character(&pi, i * 6, j * 8, ch);
-            dump_ppm_character(ch);
+    int prev = 0, c;
+    while ((c = fgetc(f)) != EOF){
+        keep[c] = 1;
+
+        if (((c == 'x') || (c == 'X')) && ((prev == '0') || (prev == '\\'))){
+            const int hi = hex_digit(fgetc(f)), lo = hex_digit(fgetc(f));
+            const int next = fgetc(f);
+
+            if ((hi >= 0) && (lo >= 0) && (hex_digit(next) < 0))
+                keep[hi << 4 | lo] = 1;
+
+            if (next != EOF)
+                ungetc(next, f);
+        }
+
+        prev = c;
+    }
+
+    fclose(f);
+}
+
+void layout_bytes(enum Layout layout, const uint8_t rows[CHARACTER_HEIGHT], uint8_t *out){
+    uint64_t packed = 0;
+
+    memset(out, 0, layouts[layout].bytes);
+
+    for (int y = 0; y < CHARACTER_HEIGHT; y++)
+    for (int x = 0; x < CHARACTER_WIDTH; x++){
+        if (!((rows[y] >> x) & 1))
+            continue;
+
+        switch (layout){
+        case LAYOUT_ROWS:    out[y] |= 1 << x; break;
+        case LAYOUT_COLUMNS: out[x] |= 1 << y; break;
+        case LAYOUT_PACKED:  packed |= (uint64_t)1 << (y * CHARACTER_WIDTH + x); break;
+        case LAYOUT_SHIFTED: out[y] |= 0x80 >> x; break;
+        default: break;
         }
     }
 
+    if (layout == LAYOUT_PACKED)
+        for (unsigned i = 0; i < layouts[layout].bytes; i++)
+            out[i] = (uint8_t)(packed >> (8 * i));
+
+    if (layout == LAYOUT_SHIFTED)
+        out[CHARACTER_HEIGHT] = out[CHARACTER_HEIGHT - 1] | (uint8_t)(0xFF << (8 - CHARACTER_WIDTH));
+}
+
+void dump_glyph(enum Layout layout, const uint8_t rows[CHARACTER_HEIGHT]){
+    uint8_t bytes[CHARACTER_HEIGHT + 1];
+    const char *delim = "";
+
+    layout_bytes(layout, rows, bytes);
+
+    printf("    { ");
+    for (unsigned i = 0; i < layouts[layout].bytes; i++, delim = ",")
+        printf("%s0x%02"PRIX8"", delim, bytes[i]);
+    printf(" },\n");
+}
+
+int main(int argc, char *argv[]){
+    static uint8_t keep[CODES_CAP], map[CODES_CAP];
+    enum Layout layout = LAYOUT_ROWS;
+    const char *ppm = NULL;
+    int subset = 0;
+
+    for (int i = 1; i < argc; i++){
+        if (!strcmp(argv[i], "-layout") && (i + 1 < argc)){
+            for (layout = 0; layout < LAYOUT_NUMBER; layout++)
+                if (!strcmp(argv[i + 1], layouts[layout].name))
+                    break;
+            if (layout == LAYOUT_NUMBER)
+                break;
+            i ++;
+        } else if (!strcmp(argv[i], "-subset") && (i + 1 < argc)){
+            subset_scan(argv[++ i], keep);
+            subset = 1;
+        } else
+            ppm = argv[i];
+    }
+
+    if (!ppm || (layout == LAYOUT_NUMBER)){
+        USAGE("%s [-layout rows|columns|packed|shifted] [-subset <file>]... <codepage.ppm>\n", *argv);
+        exit(EXIT_FAILURE);
+    }
+
+    PPM_Image pi = load_ppm_image(ppm);
+    load_codes(&pi);
     unload_ppm_image(&pi);
+
+    /* Glyph 0 is blank, dropped codes are drawn with it */
+    unsigned glyphs_number = codes_number;
+    if (subset){
+        glyphs_number = 1;
+        for (unsigned code = CONTROL_CODES; code < codes_number; code++)
+            if (keep[code] || (code < ASCII_END))
+                map[code] = (uint8_t)glyphs_number ++;
+    }
+
+    const char *name = layouts[layout].name;
+    printf("/* Generated by font/codepage_gen from codepage.ppm ( -layout %s%s ). Do not edit. */\n", name, subset ? " -subset" : "");
+    printf("#ifndef _FONT_TABLE_H\n#define _FONT_TABLE_H\n\n");
+    printf("#define FONT_CODES                  %u\n", codes_number);
+    printf("#define FONT_GLYPHS                 %u\n", glyphs_number);
+    printf("#define FONT_GLYPH_BYTES            %u\n", layouts[layout].bytes);
+
+    if (subset){
+        printf("#define FONT_SUBSET\n\n");
+        printf("const uint8_t font_map[FONT_CODES] PROGMEM = {");
+        for (unsigned code = 0; code < codes_number; code++)
+            printf("%s%u,", (code % 16) ? " " : "\n    ", map[code]);
+        printf("\n};\n");
+    }
+
+    printf("\nconst uint8_t font[FONT_GLYPHS][FONT_GLYPH_BYTES] PROGMEM = {\n");
+    if (subset){
+        dump_glyph(layout, glyphs[0]);
+        for (unsigned code = CONTROL_CODES; code < codes_number; code++)
+            if (map[code])
+                dump_glyph(layout, glyphs[code]);
+    } else
+        for (unsigned code = 0; code < codes_number; code++)
+            dump_glyph(layout, glyphs[code]);
+    printf("};\n\n#endif /* _FONT_TABLE_H */\n");
+
+    const unsigned size = glyphs_number * layouts[layout].bytes + (subset ? codes_number : 0);
+    const unsigned full = codes_number * layouts[LAYOUT_ROWS].bytes;
+    fprintf(stderr, "%s%s: %u of %u glyphs, %u bytes ( rows layout %u, %+d%% )\n", name, subset ? " subset" : "",
+            glyphs_number, codes_number, size, full, (int)(((long)size - (long)full) * 100 / (long)full));
     return 0;
-}
\ No newline at end of file
+}
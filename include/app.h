@@ -0,0 +1,46 @@
+#ifndef _APP_H
+#define _APP_H
+
+#include <inttypes.h>
+#include <assert.h>
+
+#include "shell.h"
+#include "ros.h"
+
+/* Flash layout, Makefile places sections the same way:
+   kernel | native program | ABI jump table | boot section ( BOOTSZ = 1024 words ) */
+#define APP_BASE            0x5000
+#define APP_ABI_BASE        0x7700
+#define APP_BOOT_BASE       0x7800
+#define APP_SIZE_CAP        (APP_ABI_BASE - APP_BASE)
+
+#define APP_MAGIC           0x5852      /* "RX" */
+
+#define ABI(name)   APP_ABI_##name,
+enum App_Abi {
+    #include "abi.def"
+    APP_ABI_NUMBER
+};
+#undef ABI
+
+static_assert( APP_ABI_NUMBER * 4 <= APP_BOOT_BASE - APP_ABI_BASE );
+
+/* First bytes of .rnx image. Kernel runs it if it knows at least 'abi_entries' entries */
+struct PACKED App_Header {
+    uint16_t magic;
+    uint8_t abi_entries;
+    uint8_t reserved;
+    Shell_Handler entry;
+};
+
+/* Native programs are linked at APP_BASE without startup files ( 'make apps/<name>.rnx' ):
+   - no .data or .bss, kernel owns SRAM: state lives on stack or in xram, strings in PSTR()
+   - entry is called like a shell command, argv[0] is the file name
+   - kernel is reached only through jump table: ROS_CALL(ros_puts_P)(...) */
+#define ROS_APP(main) \
+    const struct App_Header ros_app_header __attribute__((used, section(".vectors"))) = \
+        { APP_MAGIC, APP_ABI_NUMBER, 0, (main) }
+
+#define ROS_CALL(name)      ((__typeof__(&name))((APP_ABI_BASE + 4 * APP_ABI_##name) / 2))
+
+#endif /* _APP_H */
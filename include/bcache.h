@@ -0,0 +1,42 @@
+#ifndef _BCACHE_H
+#define _BCACHE_H
+
+#include <inttypes.h>
+#include <stdbool.h>
+
+#include "fs.h"
+
+/* Write-back page cache in front of any FS_Device, host-buildable like fs.c */
+#define BCACHE_LINES_CAP    6       /* Drawn from page pool while it has spare blocks */
+#define BCACHE_LINE_SIZE    FS_PAGE_SIZE
+#define BCACHE_NO_PAGE      0xFFFF
+
+enum Bcache_Flag {
+    BCACHE_FLAG_VALID = (1 << 0),
+    BCACHE_FLAG_DIRTY = (1 << 1),
+};
+
+struct FS_PACKED Bcache_Line {
+    uint16_t page;
+    uint8_t flags;
+    uint8_t data[BCACHE_LINE_SIZE];
+};
+
+struct FS_PACKED Bcache_Stats {
+    uint16_t hits;
+    uint16_t misses;
+    uint16_t readahead;         /* Lines prefetched on sequential access */
+    uint16_t bypass;            /* Whole pages read straight into caller buffer */
+    uint16_t writebacks;        /* Dirty lines written to backing device */
+};
+
+void bcache_init(const struct FS_Device *);
+int bcache_read(uint16_t, void *, uint16_t);
+int bcache_write(uint16_t, const void *, uint16_t);
+int bcache_flush(void);
+void bcache_trim(void);
+const struct Bcache_Stats *bcache_stats(void);
+
+extern struct FS_Device bcache_device;
+
+#endif /* _BCACHE_H */
@@ -0,0 +1,48 @@
+#ifndef _CHIP8_H
+#define _CHIP8_H
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <assert.h>
+
+#include "chip8_mem.h"
+#include "ros.h"
+
+#define CHIP8_STACK_DEPTH       16
+#define CHIP8_ARG_ADDR          0x001   /* r_geta / r_getb buffer, below load address */
+#define CHIP8_FORMAT_CAP        32      /* r_putf / r_getf / r_log format string */
+#define CHIP8_LINE_CAP          40      /* r_gets / r_getf line */
+#define CHIP8_TIMER_HZ          60
+#define CHIP8_BENCH_TICKS       100
+
+enum Chip8_State {
+    CHIP8_STATE_RUNNING = 0,
+    CHIP8_STATE_EXIT,                   /* r_exit */
+    CHIP8_STATE_ABORT,                  /* r_abrt */
+    CHIP8_STATE_FAULT,
+    CHIP8_STATE_TIMEOUT,                /* Run limit reached */
+};
+
+/* Timers are not decremented by anyone: value and tick it was set at give the 60 Hz count */
+struct PACKED Chip8_Regs {
+    uint8_t v[16];
+    uint16_t i;
+    uint16_t pc;
+    uint8_t sp;
+    uint8_t delay, sound;
+    uint16_t delay_tick, sound_tick;
+    uint16_t stack[CHIP8_STACK_DEPTH];
+};
+
+struct PACKED Chip8_Result {
+    uint8_t state;
+    uint8_t code;                       /* r_exit argument */
+    uint16_t pc;                        /* Faulting instruction */
+    uint16_t opcode;
+    uint32_t instructions;
+};
+
+void chip8_reset(uint8_t, char **);
+struct Chip8_Result chip8_run(uint16_t);
+
+#endif /* _CHIP8_H */
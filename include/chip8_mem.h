@@ -0,0 +1,53 @@
+#ifndef _CHIP8_MEM_H
+#define _CHIP8_MEM_H
+
+#include <inttypes.h>
+#include <stdbool.h>
+
+#include "ros.h"
+
+#define CHIP8_MEM_SIZE          0x1000
+#define CHIP8_LOAD_ADDR         0x200
+#define CHIP8_PAGE_SHIFT        6
+#define CHIP8_PAGE_SIZE         (1 << CHIP8_PAGE_SHIFT)
+#define CHIP8_PAGES_NUMBER      (CHIP8_MEM_SIZE / CHIP8_PAGE_SIZE)
+#define CHIP8_CACHE_LINES       8       /* Power of 2, direct-mapped */
+#define CHIP8_NO_PAGE           0xFF
+
+/* Cost model of cycles counter without PROFILE: SPI at F_CPU / 4 moves a byte in ~18 CPU cycles with loop overhead */
+#define CHIP8_CYCLES_HIT        12
+#define CHIP8_CYCLES_BYTE       100     /* Uncached single byte: select, command, address, data */
+#define CHIP8_CYCLES_PAGE       (CHIP8_CYCLES_BYTE + CHIP8_PAGE_SIZE * 18)
+
+static_assert( CHIP8_PAGES_NUMBER < CHIP8_NO_PAGE );
+
+enum Chip8_Line_Flag {
+    CHIP8_LINE_DIRTY = (1 << 0),
+};
+
+struct PACKED Chip8_Line {
+    uint8_t page;
+    uint8_t flags;
+    uint8_t data[CHIP8_PAGE_SIZE];
+};
+
+struct PACKED Chip8_Mem_Stats {
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t bypass;            /* Conflicts with pinned code page */
+    uint16_t writebacks;
+    uint32_t cycles;            /* Measured with PROFILE, else estimated, see CHIP8_CYCLES_* */
+};
+
+int chip8_mem_init(void);
+void chip8_mem_release(void);
+void chip8_mem_flush(void);
+
+uint16_t chip8_mem_fetch(uint16_t);
+uint8_t chip8_mem_read(uint16_t);
+void chip8_mem_write(uint16_t, uint8_t);
+int chip8_mem_load(uint16_t, const void *, uint16_t);
+
+const struct Chip8_Mem_Stats *chip8_mem_stats(void);
+
+#endif /* _CHIP8_MEM_H */
@@ -0,0 +1,45 @@
+#ifndef _CONFIG_H
+#define _CONFIG_H
+
+#include <inttypes.h>
+#include <stdbool.h>
+
+#include "ros.h"
+
+#define CONFIG_MAGIC            0x4352 /* "RC" */
+#define CONFIG_BANKS            2
+#define CONFIG_BANK_SIZE        (EEPROM_CONFIG_SIZE / CONFIG_BANKS)
+#define CONFIG_VALUE_CAP        8
+#define CONFIG_NAME_CAP         10
+#define CONFIG_END              0xFF    /* Erased cell, terminates the log */
+
+#define CONFIG(name, def, help) CONFIG_KEY_##name,
+enum Config_Key {
+    #include "config.def"
+    CONFIG_KEYS_NUMBER
+};
+#undef CONFIG
+
+/* Bank: [header][record][record]...[CONFIG_END], newest record of a key wins */
+struct PACKED Config_Bank_Header {
+    uint16_t magic;
+    uint8_t sequence;       /* Bank with newer sequence is active */
+};
+
+/* Record: [key][len][data ...][crc8], key is written last */
+struct PACKED Config_Record_Header {
+    uint8_t key;
+    uint8_t len;
+};
+
+static_assert( CONFIG_KEYS_NUMBER < CONFIG_END );
+static_assert( CONFIG_BANK_SIZE * CONFIG_BANKS <= EEPROM_CONFIG_SIZE );
+
+void config_init(void);
+void config_apply(void);
+int config_get(enum Config_Key, void *, uint8_t);
+uint8_t config_get_byte(enum Config_Key);
+int config_set(enum Config_Key, const void *, uint8_t);
+int config_find(const char *);
+
+#endif /* _CONFIG_H */
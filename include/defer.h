@@ -0,0 +1,50 @@
+#ifndef _DEFER_H
+#define _DEFER_H
+
+#include <inttypes.h>
+#include <stdbool.h>
+
+#include <avr/io.h>
+
+#include "ros.h"
+
+#define DEFER_QUEUE_CAP     16      /* Power of 2 */
+static_assert( (DEFER_QUEUE_CAP & (DEFER_QUEUE_CAP - 1)) == 0 );
+
+typedef void (*__callback Work_Routine)(uint8_t arg);
+
+struct PACKED Work {
+    Work_Routine routine;
+    uint8_t arg;
+};
+
+/* Interrupt-disabled time, in TIMER0 counts ( 64 us ), IRQ_WORST_SATURATED when it can't be told */
+enum Irq_Probe {
+    IRQ_PROBE_INT0 = 0,
+    IRQ_PROBE_TIMER0,
+    IRQ_PROBE_FLUSH,
+
+    IRQ_PROBES_NUMBER
+};
+
+#define IRQ_WORST_SATURATED     0xFFFF
+
+struct Irq_Stamp {
+    uint16_t counts;            /* Ticks * counts per tick + TIMER0 count */
+    bool pending;               /* Compare match not yet taken by its ISR */
+};
+
+extern volatile uint16_t irq_worst[IRQ_PROBES_NUMBER];
+extern volatile uint8_t defer_dropped;
+
+#define IRQ_MEASURE_BEGIN()         const struct Irq_Stamp _irq_begin = irq_stamp(0)
+/* TIMER0 compare ISR: its own match is taken on entry and counted by sched_tick() in the window */
+#define IRQ_MEASURE_BEGIN_TICK()    const struct Irq_Stamp _irq_begin = irq_stamp(1)
+#define IRQ_MEASURE_END(probe)      irq_account((probe), _irq_begin)
+
+struct Irq_Stamp irq_stamp(uint8_t);
+void irq_account(enum Irq_Probe, struct Irq_Stamp);
+void defer_init(void);
+bool defer(Work_Routine, uint8_t);
+
+#endif /* _DEFER_H */
@@ -0,0 +1,22 @@
+#ifndef _EEPROM24_H
+#define _EEPROM24_H
+
+#include <inttypes.h>
+
+#include "twi.h"
+#include "fs.h"
+
+/* 24LC256 */
+#define EEPROM24_ADDRESS        0x50
+#define EEPROM24_SIZE           32768UL
+#define EEPROM24_PAGE_SIZE      64
+#define EEPROM24_WINDOW         (TWI_QUEUE_CAP - 1)
+
+static_assert( EEPROM24_PAGE_SIZE == FS_PAGE_SIZE );
+
+int eeprom24_read(uint16_t, void *, uint16_t);
+int eeprom24_write(uint16_t, const void *, uint16_t);
+
+extern const struct FS_Device eeprom24_device;
+
+#endif /* _EEPROM24_H */
@@ -3,6 +3,7 @@
 
 #include <stddef.h>
 #include <inttypes.h>
+#include <stdbool.h>
 
 #include <avr/pgmspace.h>
 
@@ -12,193 +13,75 @@
 #define PSEUDO_GRAPHICS_BEGIN   0x7F
 #define PS(x)                   ((x) + PSEUDO_GRAPHICS_BEGIN)
 
+/* Glyph table layouts, all made by font/codepage_gen: 'make FONT_LAYOUT=<name>' picks one.
+   Renderer writes rows left to right, so 'shifted' is its fastest one, 'columns' suits
+   column-major write order and 'packed' is the smallest */
+#define FONT_LAYOUT_rows            0   /* [8] row bytes, LSB is left pixel */
+#define FONT_LAYOUT_columns         1   /* [6] column bytes, LSB is top pixel */
+#define FONT_LAYOUT_packed          2   /* [6] 6-bit rows, row N at bit 6N of 48-bit glyph */
+#define FONT_LAYOUT_shifted         3   /* [9] row bytes, MSB is left pixel, row 8 is row 7 underlined */
+
+#if !defined(FONT_LAYOUT)
+    #define FONT_LAYOUT             FONT_LAYOUT_rows
+#endif
+
+/* Left pixel of font_row() result and the next one */
+#if FONT_LAYOUT == FONT_LAYOUT_shifted
+    #define FONT_PIXEL(bits)        ((bits) & 0x80)
+    #define FONT_NEXT(bits)         ((uint8_t)((bits) << 1))
+#else
+    #define FONT_PIXEL(bits)        ((bits) & 1)
+    #define FONT_NEXT(bits)         ((uint8_t)((bits) >> 1))
+#endif
+
 #if defined(_INCLUDE_FONT)
-const uint8_t font[][8] PROGMEM = {
-    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
-    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
-    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
-    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
-    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
-    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
-    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
-    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
-    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
-    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
-    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
-    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
-    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
-    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
-    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
-    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
-    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
-    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
-    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
-    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
-    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
-    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
-    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
-    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
-    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
-    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
-    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
-    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
-    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
-    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
-    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
-    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
-
-    /* ASCII | 32 - 126 */
-    { 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x0 },
-    { 0x4,0x4,0x4,0x4,0x4,0x0,0x4,0x0 },
-    { 0xA,0xA,0x0,0x0,0x0,0x0,0x0,0x0 },
-    { 0xA,0xA,0x1F,0xA,0x1F,0xA,0xA,0x0 },
-    { 0x4,0xE,0x1,0xE,0x10,0xE,0x4,0x0 },
-    { 0x0,0x8,0x9,0x4,0x4,0x12,0x2,0x0 },
-    { 0xC,0x12,0x2,0x6,0x9,0x14,0xE,0x0 },
-    { 0x4,0x4,0x0,0x0,0x0,0x0,0x0,0x0 },
-    { 0x8,0x4,0x4,0x4,0x4,0x4,0x8,0x0 },
-    { 0x4,0x8,0x8,0x8,0x8,0x8,0x4,0x0 },
-    { 0x0,0xA,0x4,0xE,0x4,0xA,0x0,0x0 },
-    { 0x0,0x0,0x4,0xE,0x4,0x0,0x0,0x0 },
-    { 0x0,0x0,0x0,0x0,0x0,0x0,0x8,0x4 },
-    { 0x0,0x0,0x0,0xE,0x0,0x0,0x0,0x0 },
-    { 0x0,0x0,0x0,0x0,0x0,0x0,0x0,0x4 },
-    { 0x0,0x8,0x8,0x4,0x4,0x2,0x2,0x0 },
-    { 0xE,0x11,0x19,0x15,0x13,0x11,0xE,0x0 },
-    { 0x8,0xC,0x8,0x8,0x8,0x8,0x8,0x0 },
-    { 0xE,0x11,0x10,0x8,0x6,0x1,0x1F,0x0 },
-    { 0xE,0x11,0x10,0x8,0x10,0x11,0xE,0x0 },
-    { 0x11,0x11,0x11,0x1F,0x10,0x10,0x10,0x0 },
-    { 0x1E,0x1,0x1,0xE,0x10,0x11,0xE,0x0 },
-    { 0x1E,0x1,0x1,0xF,0x11,0x11,0xE,0x0 },
-    { 0x1F,0x10,0x10,0x8,0x8,0x4,0x4,0x0 },
-    { 0xE,0x11,0x11,0xE,0x11,0x11,0xE,0x0 },
-    { 0xE,0x11,0x11,0x1E,0x10,0x10,0xE,0x0 },
-    { 0x4,0x0,0x0,0x0,0x0,0x0,0x0,0x4 },
-    { 0x4,0x0,0x0,0x0,0x0,0x0,0x8,0x4 },
-    { 0x0,0x18,0x6,0x1,0x6,0x18,0x0,0x0 },
-    { 0x0,0x0,0x1E,0x0,0x1E,0x0,0x0,0x0 },
-    { 0x0,0x3,0xC,0x10,0xC,0x3,0x0,0x0 },
-    { 0xE,0x11,0x10,0x8,0x4,0x4,0x0,0x4 },
-    { 0xE,0x13,0x19,0x15,0x15,0x19,0x1E,0x20 },
-    { 0x4,0xA,0xA,0xE,0xA,0x11,0x11,0x0 },
-    { 0xF,0x11,0x11,0xF,0x11,0x11,0xF,0x0 },
-    { 0xE,0x11,0x1,0x1,0x1,0x11,0xE,0x0 },
-    { 0xF,0x11,0x11,0x11,0x11,0x11,0xF,0x0 },
-    { 0x1F,0x1,0x1,0xF,0x1,0x1,0x1F,0x0 },
-    { 0x1F,0x1,0x1,0xF,0x1,0x1,0x1,0x0 },
-    { 0xE,0x11,0x1,0x1,0x9,0x19,0xE,0x0 },
-    { 0x11,0x11,0x11,0x1F,0x11,0x11,0x11,0x0 },
-    { 0x1F,0x4,0x4,0x4,0x4,0x4,0x1F,0x0 },
-    { 0x1E,0x5,0x4,0x4,0x4,0x4,0x3,0x0 },
-    { 0x11,0x9,0x5,0x3,0x5,0x9,0x11,0x0 },
-    { 0x1,0x1,0x1,0x1,0x1,0x1,0x1F,0x0 },
-    { 0x1B,0x15,0x15,0x11,0x11,0x11,0x11,0x0 },
-    { 0x13,0x15,0x15,0x15,0x15,0x15,0x19,0x0 },
-    { 0xE,0x11,0x11,0x11,0x11,0x11,0xE,0x0 },
-    { 0xF,0x11,0x11,0xF,0x1,0x1,0x1,0x0 },
-    { 0xE,0x11,0x11,0x11,0x11,0x19,0x1E,0x20 },
-    { 0xF,0x11,0x11,0xF,0x5,0x9,0x11,0x0 },
-    { 0x1E,0x1,0x1,0xE,0x10,0x10,0xF,0x0 },
-    { 0x1F,0x4,0x4,0x4,0x4,0x4,0x4,0x0 },
-    { 0x11,0x11,0x11,0x11,0x11,0x11,0xE,0x0 },
-    { 0x11,0x11,0x11,0x11,0xA,0xA,0x4,0x0 },
-    { 0x11,0x11,0x11,0x15,0x15,0x15,0xA,0x0 },
-    { 0x11,0xA,0xA,0x4,0xA,0xA,0x11,0x0 },
-    { 0x11,0xA,0xA,0x4,0x4,0x4,0x4,0x0 },
-    { 0x1F,0x10,0x8,0x4,0x2,0x1,0x1F,0x0 },
-    { 0xC,0x4,0x4,0x4,0x4,0x4,0xC,0x0 },
-    { 0x0,0x2,0x2,0x4,0x4,0x8,0x8,0x0 },
-    { 0xC,0x8,0x8,0x8,0x8,0x8,0xC,0x0 },
-    { 0x4,0xA,0xA,0x11,0x0,0x0,0x0,0x0 },
-    { 0x0,0x0,0x0,0x0,0x0,0x0,0x1F,0x0 },
-    { 0x2,0x4,0x0,0x0,0x0,0x0,0x0,0x0 },
-    { 0x0,0x6,0x9,0x8,0xE,0x9,0x1E,0x0 },
-    { 0x2,0x2,0x2,0xE,0x12,0x12,0xE,0x0 },
-    { 0x0,0x0,0xC,0x12,0x2,0x12,0xC,0x0 },
-    { 0x10,0x10,0x10,0x1C,0x12,0x12,0x1C,0x0 },
-    { 0x0,0x0,0xC,0x12,0xE,0x2,0xC,0x0 },
-    { 0xC,0x12,0x2,0xF,0x2,0x2,0x2,0x0 },
-    { 0x0,0x0,0x1E,0x9,0x9,0xE,0x8,0x6 },
-    { 0x2,0x2,0x2,0xE,0x12,0x12,0x12,0x0 },
-    { 0x0,0x4,0x0,0x4,0x4,0x4,0x4,0x0 },
-    { 0x0,0x4,0x0,0x6,0x4,0x4,0x4,0x2 },
-    { 0x2,0x2,0x2,0xA,0x6,0xA,0xA,0x0 },
-    { 0x0,0x4,0x4,0x4,0x4,0x6,0x4,0x0 },
-    { 0x0,0x0,0xF,0x15,0x15,0x15,0x15,0x0 },
-    { 0x0,0x0,0xE,0x12,0x12,0x12,0x12,0x0 },
-    { 0x0,0x0,0xE,0x11,0x11,0x11,0xE,0x0 },
-    { 0x0,0x0,0xE,0x12,0x12,0xE,0x2,0x2 },
-    { 0x0,0x0,0xC,0x12,0x12,0x1C,0x10,0x10 },
-    { 0x0,0x0,0x1A,0x6,0x2,0x2,0x2,0x0 },
-    { 0x0,0x0,0x1C,0x2,0xC,0x10,0xE,0x0 },
-    { 0x4,0x4,0xE,0x4,0x4,0x4,0x4,0x8 },
-    { 0x0,0x0,0x12,0x12,0x12,0x12,0xC,0x0 },
-    { 0x0,0x0,0x11,0x11,0xA,0xA,0x4,0x0 },
-    { 0x0,0x0,0x11,0x11,0x11,0x15,0xA,0x0 },
-    { 0x0,0x0,0xA,0xA,0x4,0xA,0xA,0x0 },
-    { 0x0,0x0,0xA,0xA,0xA,0xC,0x8,0x4 },
-    { 0x0,0x0,0xE,0x8,0x4,0x2,0xE,0x0 },
-    { 0x8,0x4,0x4,0x2,0x4,0x4,0x8,0x0 },
-    { 0x0,0x4,0x4,0x4,0x4,0x4,0x4,0x0 },
-    { 0x4,0x8,0x8,0x10,0x8,0x8,0x4,0x0 },
-    { 0x0,0x0,0x0,0x14,0xA,0x0,0x0,0x0 },
-
-    /* Pseudo graphics */
-    { 0x11,0x0,0x22,0x0,0x11,0x0,0x22,0x0 },
-    { 0x15,0x2A,0x15,0x2A,0x15,0x2A,0x15,0x2A },
-    { 0x2E,0x3F,0x1D,0x3F,0x2E,0x3F,0x1D,0x3F },
-    { 0xC,0xC,0xC,0xC,0xC,0xC,0xC,0xC },
-    { 0xC,0xC,0xC,0xF,0xF,0xC,0xC,0xC },
-    { 0xC,0xC,0xF,0x8,0x8,0xF,0xC,0xC },
-    { 0x12,0x12,0x12,0x13,0x13,0x12,0x12,0x12 },
-    { 0x0,0x0,0x0,0x1F,0x13,0x12,0x12,0x12 },
-    { 0x0,0x0,0xF,0x8,0x8,0xF,0xC,0xC },
-    { 0x12,0x12,0x13,0x10,0x10,0x13,0x12,0x12 },
-    { 0x12,0x12,0x12,0x12,0x12,0x12,0x12,0x12 },
-    { 0x0,0x0,0x1F,0x10,0x10,0x13,0x12,0x12 },
-    { 0x12,0x12,0x13,0x10,0x10,0x1F,0x0,0x0 },
-    { 0x12,0x12,0x12,0x13,0x1F,0x0,0x0,0x0 },
-    { 0xC,0xC,0xF,0x8,0x8,0xF,0x0,0x0 },
-    { 0x0,0x0,0x0,0xF,0xF,0xC,0xC,0xC },
-    { 0xC,0xC,0xC,0x3C,0x3C,0x0,0x0,0x0 },
-    { 0xC,0xC,0xC,0x3F,0x3F,0x0,0x0,0x0 },
-    { 0x0,0x0,0x0,0x3F,0x3F,0xC,0xC,0xC },
-    { 0xC,0xC,0xC,0x3C,0x3C,0xC,0xC,0xC },
-    { 0x0,0x0,0x0,0x3F,0x3F,0x0,0x0,0x0 },
-    { 0xC,0xC,0xC,0x3F,0x3F,0xC,0xC,0xC },
-    { 0xC,0xC,0x3C,0x4,0x4,0x3C,0xC,0xC },
-    { 0x12,0x12,0x12,0x32,0x32,0x12,0x12,0x12 },
-    { 0x12,0x12,0x32,0x2,0x2,0x3E,0x0,0x0 },
-    { 0x0,0x0,0x3E,0x2,0x2,0x32,0x12,0x12 },
-    { 0x12,0x12,0x33,0x0,0x0,0x3F,0x0,0x0 },
-    { 0x0,0x0,0x3F,0x0,0x0,0x33,0x12,0x12 },
-    { 0x12,0x12,0x32,0x2,0x2,0x32,0x12,0x12 },
-    { 0x0,0x0,0x3F,0x0,0x0,0x3F,0x0,0x0 },
-    { 0x12,0x12,0x33,0x0,0x0,0x33,0x12,0x12 },
-    { 0xC,0xC,0x3F,0x0,0x0,0x3F,0x0,0x0 },
-    { 0x12,0x12,0x12,0x33,0x3F,0x0,0x0,0x0 },
-    { 0x0,0x0,0x3F,0x0,0x0,0x3F,0xC,0xC },
-    { 0x0,0x0,0x0,0x3F,0x33,0x12,0x12,0x12 },
-    { 0x12,0x12,0x12,0x32,0x3E,0x0,0x0,0x0 },
-    { 0xC,0xC,0x3C,0x4,0x4,0x3C,0x0,0x0 },
-    { 0x0,0x0,0x3C,0x4,0x4,0x3C,0xC,0xC },
-    { 0x0,0x0,0x0,0x3E,0x32,0x12,0x12,0x12 },
-    { 0x12,0x12,0x12,0x3F,0x3F,0x12,0x12,0x12 },
-    { 0xC,0xC,0x3F,0xC,0xC,0x3F,0xC,0xC },
-    { 0xC,0xC,0xC,0xF,0xF,0x0,0x0,0x0 },
-    { 0x0,0x0,0x0,0x3C,0x3C,0xC,0xC,0xC },
-    { 0x3F,0x3F,0x3F,0x3F,0x3F,0x3F,0x3F,0x3F },
-    { 0x0,0x0,0x0,0x0,0x3F,0x3F,0x3F,0x3F },
-    { 0x7,0x7,0x7,0x7,0x7,0x7,0x7,0x7 },
-    { 0x38,0x38,0x38,0x38,0x38,0x38,0x38,0x38 },
-    { 0x3F,0x3F,0x3F,0x3F,0x0,0x0,0x0,0x0 },
-    { 0xC,0x12,0x12,0xC,0x0,0x0,0x0,0x0 },
-    { 0x0,0x0,0x1E,0x1E,0x1E,0x1E,0x0,0x0 },
-
-    /* Error character */
-    { 0x1B,0x29,0x29,0x1B,0x29,0x29,0x29,0x2B },
-};
+
+/* 'make FONT_SUBSET=1': glyphs the sources do not use are dropped, font_map[] indexes the rest */
+#if defined(FONT_SUBSET_TABLE)
+    #include "font_subset.h"
+#elif FONT_LAYOUT == FONT_LAYOUT_rows
+    #include "font_rows.h"
+#elif FONT_LAYOUT == FONT_LAYOUT_columns
+    #include "font_columns.h"
+#elif FONT_LAYOUT == FONT_LAYOUT_packed
+    #include "font_packed.h"
+#elif FONT_LAYOUT == FONT_LAYOUT_shifted
+    #include "font_shifted.h"
+#else
+    #error "Unknown FONT_LAYOUT"
+#endif
+
+/* Row of a glyph, see FONT_PIXEL(). Codes past the table get its last glyph */
+static inline uint8_t font_row(unsigned char let, uint8_t row, bool underline) {
+    const bool line = underline && (row == LETTER_HEIGHT - 1);
+    uint8_t bits = 0;
+
+    if (let > FONT_CODES - 1)
+        let = FONT_CODES - 1;
+
+#if defined(FONT_SUBSET)
+    let = pgm_read_byte(&font_map[let]);
+#endif
+
+#if FONT_LAYOUT == FONT_LAYOUT_rows
+    bits = pgm_read_byte(&font[let][row]);
+#elif FONT_LAYOUT == FONT_LAYOUT_columns
+    for (uint8_t col = 0; col < LETTER_WIDTH; col++)
+        bits |= ((pgm_read_byte(&font[let][col]) >> row) & 1) << col;
+#elif FONT_LAYOUT == FONT_LAYOUT_packed
+    const uint8_t bit = row * LETTER_WIDTH;
+    uint16_t pair = pgm_read_byte(&font[let][bit / 8]);
+
+    if (bit / 8 + 1 < FONT_GLYPH_BYTES)
+        pair |= (uint16_t)pgm_read_byte(&font[let][bit / 8 + 1]) << 8;
+    bits = (uint8_t)(pair >> (bit % 8)) & ((1 << LETTER_WIDTH) - 1);
+#elif FONT_LAYOUT == FONT_LAYOUT_shifted
+    return pgm_read_byte(&font[let][line ? LETTER_HEIGHT : row]);
+#endif
+
+    return line ? (1 << LETTER_WIDTH) - 1 : bits;
+}
+
 #endif /* _INCLUDE_FONT */
 
-#endif /* _FONT_H */
\ No newline at end of file
+#endif /* _FONT_H */
@@ -0,0 +1,190 @@
+/* Generated by font/codepage_gen from codepage.ppm ( -layout columns ). Do not edit. */
+#ifndef _FONT_TABLE_H
+#define _FONT_TABLE_H
+
+#define FONT_CODES                  178
+#define FONT_GLYPHS                 178
+#define FONT_GLYPH_BYTES            6
+
+const uint8_t font[FONT_GLYPHS][FONT_GLYPH_BYTES] PROGMEM = {
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x5F,0x00,0x00,0x00 },
+    { 0x00,0x03,0x00,0x03,0x00,0x00 },
+    { 0x14,0x7F,0x14,0x7F,0x14,0x00 },
+    { 0x04,0x2A,0x6B,0x2A,0x10,0x00 },
+    { 0x04,0x60,0x18,0x06,0x20,0x00 },
+    { 0x10,0x4E,0x69,0x51,0x22,0x00 },
+    { 0x00,0x00,0x03,0x00,0x00,0x00 },
+    { 0x00,0x00,0x3E,0x41,0x00,0x00 },
+    { 0x00,0x00,0x41,0x3E,0x00,0x00 },
+    { 0x00,0x2A,0x1C,0x2A,0x00,0x00 },
+    { 0x00,0x08,0x1C,0x08,0x00,0x00 },
+    { 0x00,0x00,0x80,0x40,0x00,0x00 },
+    { 0x00,0x08,0x08,0x08,0x00,0x00 },
+    { 0x00,0x00,0x80,0x00,0x00,0x00 },
+    { 0x00,0x60,0x18,0x06,0x00,0x00 },
+    { 0x3E,0x51,0x49,0x45,0x3E,0x00 },
+    { 0x00,0x00,0x02,0x7F,0x00,0x00 },
+    { 0x62,0x51,0x51,0x49,0x46,0x00 },
+    { 0x22,0x41,0x41,0x49,0x36,0x00 },
+    { 0x0F,0x08,0x08,0x08,0x7F,0x00 },
+    { 0x26,0x49,0x49,0x49,0x31,0x00 },
+    { 0x3E,0x49,0x49,0x49,0x31,0x00 },
+    { 0x01,0x01,0x61,0x19,0x07,0x00 },
+    { 0x36,0x49,0x49,0x49,0x36,0x00 },
+    { 0x06,0x49,0x49,0x49,0x3E,0x00 },
+    { 0x00,0x00,0x81,0x00,0x00,0x00 },
+    { 0x00,0x00,0x81,0x40,0x00,0x00 },
+    { 0x08,0x14,0x14,0x22,0x22,0x00 },
+    { 0x00,0x14,0x14,0x14,0x14,0x00 },
+    { 0x22,0x22,0x14,0x14,0x08,0x00 },
+    { 0x02,0x01,0xB1,0x09,0x06,0x00 },
+    { 0x3E,0x43,0x59,0x65,0x7E,0x80 },
+    { 0x60,0x1E,0x09,0x1E,0x60,0x00 },
+    { 0x7F,0x49,0x49,0x49,0x36,0x00 },
+    { 0x3E,0x41,0x41,0x41,0x22,0x00 },
+    { 0x7F,0x41,0x41,0x41,0x3E,0x00 },
+    { 0x7F,0x49,0x49,0x49,0x41,0x00 },
+    { 0x7F,0x09,0x09,0x09,0x01,0x00 },
+    { 0x3E,0x41,0x41,0x71,0x22,0x00 },
+    { 0x7F,0x08,0x08,0x08,0x7F,0x00 },
+    { 0x41,0x41,0x7F,0x41,0x41,0x00 },
+    { 0x42,0x41,0x3F,0x01,0x01,0x00 },
+    { 0x7F,0x08,0x14,0x22,0x41,0x00 },
+    { 0x7F,0x40,0x40,0x40,0x40,0x00 },
+    { 0x7F,0x01,0x06,0x01,0x7F,0x00 },
+    { 0x7F,0x01,0x3E,0x40,0x7F,0x00 },
+    { 0x3E,0x41,0x41,0x41,0x3E,0x00 },
+    { 0x7F,0x09,0x09,0x09,0x06,0x00 },
+    { 0x3E,0x41,0x41,0x61,0x7E,0x80 },
+    { 0x7F,0x09,0x19,0x29,0x46,0x00 },
+    { 0x46,0x49,0x49,0x49,0x31,0x00 },
+    { 0x01,0x01,0x7F,0x01,0x01,0x00 },
+    { 0x3F,0x40,0x40,0x40,0x3F,0x00 },
+    { 0x0F,0x30,0x40,0x30,0x0F,0x00 },
+    { 0x3F,0x40,0x38,0x40,0x3F,0x00 },
+    { 0x41,0x36,0x08,0x36,0x41,0x00 },
+    { 0x01,0x06,0x78,0x06,0x01,0x00 },
+    { 0x61,0x51,0x49,0x45,0x43,0x00 },
+    { 0x00,0x00,0x7F,0x41,0x00,0x00 },
+    { 0x00,0x06,0x18,0x60,0x00,0x00 },
+    { 0x00,0x00,0x41,0x7F,0x00,0x00 },
+    { 0x08,0x06,0x01,0x06,0x08,0x00 },
+    { 0x40,0x40,0x40,0x40,0x40,0x00 },
+    { 0x00,0x01,0x02,0x00,0x00,0x00 },
+    { 0x24,0x52,0x52,0x7C,0x40,0x00 },
+    { 0x00,0x7F,0x48,0x48,0x30,0x00 },
+    { 0x00,0x38,0x44,0x44,0x28,0x00 },
+    { 0x00,0x30,0x48,0x48,0x7F,0x00 },
+    { 0x00,0x38,0x54,0x54,0x08,0x00 },
+    { 0x08,0x7E,0x09,0x09,0x02,0x00 },
+    { 0x18,0xA4,0xA4,0x7C,0x04,0x00 },
+    { 0x00,0x7F,0x08,0x08,0x70,0x00 },
+    { 0x00,0x00,0x7A,0x00,0x00,0x00 },
+    { 0x00,0x88,0x7A,0x00,0x00,0x00 },
+    { 0x00,0x7F,0x10,0x68,0x00,0x00 },
+    { 0x00,0x20,0x7E,0x00,0x00,0x00 },
+    { 0x7C,0x04,0x7C,0x04,0x78,0x00 },
+    { 0x00,0x7C,0x04,0x04,0x78,0x00 },
+    { 0x38,0x44,0x44,0x44,0x38,0x00 },
+    { 0x00,0xFC,0x24,0x24,0x18,0x00 },
+    { 0x00,0x18,0x24,0x24,0xF8,0x00 },
+    { 0x00,0x7C,0x08,0x04,0x04,0x00 },
+    { 0x00,0x48,0x54,0x54,0x24,0x00 },
+    { 0x00,0x04,0x7F,0x84,0x00,0x00 },
+    { 0x00,0x3C,0x40,0x40,0x3C,0x00 },
+    { 0x0C,0x30,0x40,0x30,0x0C,0x00 },
+    { 0x3C,0x40,0x20,0x40,0x3C,0x00 },
+    { 0x00,0x6C,0x10,0x6C,0x00,0x00 },
+    { 0x00,0x1C,0xA0,0x7C,0x00,0x00 },
+    { 0x00,0x64,0x54,0x4C,0x00,0x00 },
+    { 0x00,0x08,0x36,0x41,0x00,0x00 },
+    { 0x00,0x00,0x7E,0x00,0x00,0x00 },
+    { 0x00,0x00,0x41,0x36,0x08,0x00 },
+    { 0x00,0x10,0x08,0x10,0x08,0x00 },
+    { 0x11,0x44,0x00,0x00,0x11,0x44 },
+    { 0x55,0xAA,0x55,0xAA,0x55,0xAA },
+    { 0xEE,0xBB,0xFF,0xFF,0xEE,0xBB },
+    { 0x00,0x00,0xFF,0xFF,0x00,0x00 },
+    { 0x18,0x18,0xFF,0xFF,0x00,0x00 },
+    { 0x24,0x24,0xE7,0xFF,0x00,0x00 },
+    { 0x18,0xFF,0x00,0x00,0xFF,0x00 },
+    { 0x18,0xF8,0x08,0x08,0xF8,0x00 },
+    { 0x24,0x24,0xE4,0xFC,0x00,0x00 },
+    { 0x24,0xE7,0x00,0x00,0xFF,0x00 },
+    { 0x00,0xFF,0x00,0x00,0xFF,0x00 },
+    { 0x24,0xE4,0x04,0x04,0xFC,0x00 },
+    { 0x24,0x27,0x20,0x20,0x3F,0x00 },
+    { 0x18,0x1F,0x10,0x10,0x1F,0x00 },
+    { 0x24,0x24,0x27,0x3F,0x00,0x00 },
+    { 0x18,0x18,0xF8,0xF8,0x00,0x00 },
+    { 0x00,0x00,0x1F,0x1F,0x18,0x18 },
+    { 0x18,0x18,0x1F,0x1F,0x18,0x18 },
+    { 0x18,0x18,0xF8,0xF8,0x18,0x18 },
+    { 0x00,0x00,0xFF,0xFF,0x18,0x18 },
+    { 0x18,0x18,0x18,0x18,0x18,0x18 },
+    { 0x18,0x18,0xFF,0xFF,0x18,0x18 },
+    { 0x00,0x00,0xFF,0xE7,0x24,0x24 },
+    { 0x00,0xFF,0x00,0x00,0xFF,0x18 },
+    { 0x00,0x3F,0x20,0x20,0x27,0x24 },
+    { 0x00,0xFC,0x04,0x04,0xE4,0x24 },
+    { 0x24,0x27,0x20,0x20,0x27,0x24 },
+    { 0x24,0xE4,0x04,0x04,0xE4,0x24 },
+    { 0x00,0xFF,0x00,0x00,0xE7,0x24 },
+    { 0x24,0x24,0x24,0x24,0x24,0x24 },
+    { 0x24,0xE7,0x00,0x00,0xE7,0x24 },
+    { 0x24,0x24,0x27,0x27,0x24,0x24 },
+    { 0x18,0x1F,0x10,0x10,0x1F,0x18 },
+    { 0x24,0x24,0xE4,0xE4,0x24,0x24 },
+    { 0x18,0xF8,0x08,0x08,0xF8,0x18 },
+    { 0x00,0x1F,0x10,0x10,0x1F,0x18 },
+    { 0x00,0x00,0x3F,0x27,0x24,0x24 },
+    { 0x00,0x00,0xFC,0xE4,0x24,0x24 },
+    { 0x00,0xF8,0x08,0x08,0xF8,0x18 },
+    { 0x18,0xFF,0x18,0x18,0xFF,0x18 },
+    { 0x24,0x24,0xFF,0xFF,0x24,0x24 },
+    { 0x18,0x18,0x1F,0x1F,0x00,0x00 },
+    { 0x00,0x00,0xF8,0xF8,0x18,0x18 },
+    { 0xFF,0xFF,0xFF,0xFF,0xFF,0xFF },
+    { 0xF0,0xF0,0xF0,0xF0,0xF0,0xF0 },
+    { 0xFF,0xFF,0xFF,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0xFF,0xFF,0xFF },
+    { 0x0F,0x0F,0x0F,0x0F,0x0F,0x0F },
+    { 0x00,0x06,0x09,0x09,0x06,0x00 },
+    { 0x00,0x3C,0x3C,0x3C,0x3C,0x00 },
+    { 0xFF,0x89,0x00,0xFF,0x09,0xF6 },
+};
+
+#endif /* _FONT_TABLE_H */
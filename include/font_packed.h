@@ -0,0 +1,190 @@
+/* Generated by font/codepage_gen from codepage.ppm ( -layout packed ). Do not edit. */
+#ifndef _FONT_TABLE_H
+#define _FONT_TABLE_H
+
+#define FONT_CODES                  178
+#define FONT_GLYPHS                 178
+#define FONT_GLYPH_BYTES            6
+
+const uint8_t font[FONT_GLYPHS][FONT_GLYPH_BYTES] PROGMEM = {
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x04,0x41,0x10,0x04,0x40,0x00 },
+    { 0x8A,0x02,0x00,0x00,0x00,0x00 },
+    { 0x8A,0xF2,0x29,0x9F,0xA2,0x00 },
+    { 0x84,0x13,0x38,0x90,0x43,0x00 },
+    { 0x00,0x92,0x10,0x84,0x24,0x00 },
+    { 0x8C,0x24,0x18,0x09,0xE5,0x00 },
+    { 0x04,0x01,0x00,0x00,0x00,0x00 },
+    { 0x08,0x41,0x10,0x04,0x81,0x00 },
+    { 0x04,0x82,0x20,0x08,0x42,0x00 },
+    { 0x80,0x42,0x38,0x84,0x02,0x00 },
+    { 0x00,0x40,0x38,0x04,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x80,0x10 },
+    { 0x00,0x00,0x38,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x10 },
+    { 0x00,0x82,0x10,0x84,0x20,0x00 },
+    { 0x4E,0x94,0x55,0x53,0xE4,0x00 },
+    { 0x08,0x83,0x20,0x08,0x82,0x00 },
+    { 0x4E,0x04,0x21,0x46,0xF0,0x01 },
+    { 0x4E,0x04,0x21,0x50,0xE4,0x00 },
+    { 0x51,0x14,0x7D,0x10,0x04,0x01 },
+    { 0x5E,0x10,0x38,0x50,0xE4,0x00 },
+    { 0x5E,0x10,0x3C,0x51,0xE4,0x00 },
+    { 0x1F,0x04,0x21,0x08,0x41,0x00 },
+    { 0x4E,0x14,0x39,0x51,0xE4,0x00 },
+    { 0x4E,0x14,0x79,0x10,0xE4,0x00 },
+    { 0x04,0x00,0x00,0x00,0x00,0x10 },
+    { 0x04,0x00,0x00,0x00,0x80,0x10 },
+    { 0x00,0x66,0x04,0x06,0x06,0x00 },
+    { 0x00,0xE0,0x01,0x1E,0x00,0x00 },
+    { 0xC0,0xC0,0x40,0xCC,0x00,0x00 },
+    { 0x4E,0x04,0x21,0x04,0x01,0x10 },
+    { 0xCE,0x94,0x55,0x55,0xE6,0x81 },
+    { 0x84,0xA2,0x38,0x4A,0x14,0x01 },
+    { 0x4F,0x14,0x3D,0x51,0xF4,0x00 },
+    { 0x4E,0x14,0x04,0x41,0xE4,0x00 },
+    { 0x4F,0x14,0x45,0x51,0xF4,0x00 },
+    { 0x5F,0x10,0x3C,0x41,0xF0,0x01 },
+    { 0x5F,0x10,0x3C,0x41,0x10,0x00 },
+    { 0x4E,0x14,0x04,0x49,0xE6,0x00 },
+    { 0x51,0x14,0x7D,0x51,0x14,0x01 },
+    { 0x1F,0x41,0x10,0x04,0xF1,0x01 },
+    { 0x5E,0x41,0x10,0x04,0x31,0x00 },
+    { 0x51,0x52,0x0C,0x45,0x12,0x01 },
+    { 0x41,0x10,0x04,0x41,0xF0,0x01 },
+    { 0x5B,0x55,0x45,0x51,0x14,0x01 },
+    { 0x53,0x55,0x55,0x55,0x95,0x01 },
+    { 0x4E,0x14,0x45,0x51,0xE4,0x00 },
+    { 0x4F,0x14,0x3D,0x41,0x10,0x00 },
+    { 0x4E,0x14,0x45,0x51,0xE6,0x81 },
+    { 0x4F,0x14,0x3D,0x45,0x12,0x01 },
+    { 0x5E,0x10,0x38,0x10,0xF4,0x00 },
+    { 0x1F,0x41,0x10,0x04,0x41,0x00 },
+    { 0x51,0x14,0x45,0x51,0xE4,0x00 },
+    { 0x51,0x14,0x45,0x8A,0x42,0x00 },
+    { 0x51,0x14,0x55,0x55,0xA5,0x00 },
+    { 0x91,0xA2,0x10,0x8A,0x12,0x01 },
+    { 0x91,0xA2,0x10,0x04,0x41,0x00 },
+    { 0x1F,0x84,0x10,0x42,0xF0,0x01 },
+    { 0x0C,0x41,0x10,0x04,0xC1,0x00 },
+    { 0x80,0x20,0x10,0x04,0x82,0x00 },
+    { 0x0C,0x82,0x20,0x08,0xC2,0x00 },
+    { 0x84,0xA2,0x44,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0xF0,0x01 },
+    { 0x02,0x01,0x00,0x00,0x00,0x00 },
+    { 0x80,0x91,0x20,0x4E,0xE2,0x01 },
+    { 0x82,0x20,0x38,0x92,0xE4,0x00 },
+    { 0x00,0xC0,0x48,0x82,0xC4,0x00 },
+    { 0x10,0x04,0x71,0x92,0xC4,0x01 },
+    { 0x00,0xC0,0x48,0x8E,0xC0,0x00 },
+    { 0x8C,0x24,0x3C,0x82,0x20,0x00 },
+    { 0x00,0xE0,0x25,0x89,0x83,0x18 },
+    { 0x82,0x20,0x38,0x92,0x24,0x01 },
+    { 0x00,0x01,0x10,0x04,0x41,0x00 },
+    { 0x00,0x01,0x18,0x04,0x41,0x08 },
+    { 0x82,0x20,0x28,0x86,0xA2,0x00 },
+    { 0x00,0x41,0x10,0x84,0x41,0x00 },
+    { 0x00,0xF0,0x54,0x55,0x55,0x01 },
+    { 0x00,0xE0,0x48,0x92,0x24,0x01 },
+    { 0x00,0xE0,0x44,0x51,0xE4,0x00 },
+    { 0x00,0xE0,0x48,0x92,0x23,0x08 },
+    { 0x00,0xC0,0x48,0x12,0x07,0x41 },
+    { 0x00,0xA0,0x19,0x82,0x20,0x00 },
+    { 0x00,0xC0,0x09,0x0C,0xE4,0x00 },
+    { 0x04,0xE1,0x10,0x04,0x41,0x20 },
+    { 0x00,0x20,0x49,0x92,0xC4,0x00 },
+    { 0x00,0x10,0x45,0x8A,0x42,0x00 },
+    { 0x00,0x10,0x45,0x51,0xA5,0x00 },
+    { 0x00,0xA0,0x28,0x84,0xA2,0x00 },
+    { 0x00,0xA0,0x28,0x0A,0x83,0x10 },
+    { 0x00,0xE0,0x20,0x84,0xE0,0x00 },
+    { 0x08,0x41,0x08,0x04,0x81,0x00 },
+    { 0x00,0x41,0x10,0x04,0x41,0x00 },
+    { 0x04,0x82,0x40,0x08,0x42,0x00 },
+    { 0x00,0x00,0x50,0x0A,0x00,0x00 },
+    { 0x11,0x20,0x02,0x11,0x20,0x02 },
+    { 0x95,0x5A,0xA9,0x95,0x5A,0xA9 },
+    { 0xEE,0xDF,0xFD,0xEE,0xDF,0xFD },
+    { 0x0C,0xC3,0x30,0x0C,0xC3,0x30 },
+    { 0x0C,0xC3,0x3C,0x0F,0xC3,0x30 },
+    { 0x0C,0xF3,0x20,0xC8,0xC3,0x30 },
+    { 0x92,0x24,0x4D,0x93,0x24,0x49 },
+    { 0x00,0x00,0x7C,0x93,0x24,0x49 },
+    { 0x00,0xF0,0x20,0xC8,0xC3,0x30 },
+    { 0x92,0x34,0x41,0xD0,0x24,0x49 },
+    { 0x92,0x24,0x49,0x92,0x24,0x49 },
+    { 0x00,0xF0,0x41,0xD0,0x24,0x49 },
+    { 0x92,0x34,0x41,0xD0,0x07,0x00 },
+    { 0x92,0x24,0x4D,0x1F,0x00,0x00 },
+    { 0x0C,0xF3,0x20,0xC8,0x03,0x00 },
+    { 0x00,0x00,0x3C,0x0F,0xC3,0x30 },
+    { 0x0C,0xC3,0xF0,0x3C,0x00,0x00 },
+    { 0x0C,0xC3,0xFC,0x3F,0x00,0x00 },
+    { 0x00,0x00,0xFC,0x3F,0xC3,0x30 },
+    { 0x0C,0xC3,0xF0,0x3C,0xC3,0x30 },
+    { 0x00,0x00,0xFC,0x3F,0x00,0x00 },
+    { 0x0C,0xC3,0xFC,0x3F,0xC3,0x30 },
+    { 0x0C,0xC3,0x13,0x04,0xCF,0x30 },
+    { 0x92,0x24,0xC9,0xB2,0x24,0x49 },
+    { 0x92,0x24,0x0B,0x82,0x0F,0x00 },
+    { 0x00,0xE0,0x0B,0x82,0x2C,0x49 },
+    { 0x92,0x34,0x03,0xC0,0x0F,0x00 },
+    { 0x00,0xF0,0x03,0xC0,0x2C,0x49 },
+    { 0x92,0x24,0x0B,0x82,0x2C,0x49 },
+    { 0x00,0xF0,0x03,0xC0,0x0F,0x00 },
+    { 0x92,0x34,0x03,0xC0,0x2C,0x49 },
+    { 0x0C,0xF3,0x03,0xC0,0x0F,0x00 },
+    { 0x92,0x24,0xCD,0x3F,0x00,0x00 },
+    { 0x00,0xF0,0x03,0xC0,0xCF,0x30 },
+    { 0x00,0x00,0xFC,0xB3,0x24,0x49 },
+    { 0x92,0x24,0xC9,0x3E,0x00,0x00 },
+    { 0x0C,0xC3,0x13,0x04,0x0F,0x00 },
+    { 0x00,0xC0,0x13,0x04,0xCF,0x30 },
+    { 0x00,0x00,0xF8,0xB2,0x24,0x49 },
+    { 0x92,0x24,0xFD,0xBF,0x24,0x49 },
+    { 0x0C,0xF3,0x33,0xCC,0xCF,0x30 },
+    { 0x0C,0xC3,0x3C,0x0F,0x00,0x00 },
+    { 0x00,0x00,0xF0,0x3C,0xC3,0x30 },
+    { 0xFF,0xFF,0xFF,0xFF,0xFF,0xFF },
+    { 0x00,0x00,0x00,0xFF,0xFF,0xFF },
+    { 0xC7,0x71,0x1C,0xC7,0x71,0x1C },
+    { 0x38,0x8E,0xE3,0x38,0x8E,0xE3 },
+    { 0xFF,0xFF,0xFF,0x00,0x00,0x00 },
+    { 0x8C,0x24,0x31,0x00,0x00,0x00 },
+    { 0x00,0xE0,0x79,0x9E,0x07,0x00 },
+    { 0x5B,0x9A,0x6E,0x69,0x9A,0xAE },
+};
+
+#endif /* _FONT_TABLE_H */
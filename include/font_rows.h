@@ -0,0 +1,190 @@
+/* Generated by font/codepage_gen from codepage.ppm ( -layout rows ). Do not edit. */
+#ifndef _FONT_TABLE_H
+#define _FONT_TABLE_H
+
+#define FONT_CODES                  178
+#define FONT_GLYPHS                 178
+#define FONT_GLYPH_BYTES            8
+
+const uint8_t font[FONT_GLYPHS][FONT_GLYPH_BYTES] PROGMEM = {
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x04,0x04,0x04,0x04,0x04,0x00,0x04,0x00 },
+    { 0x0A,0x0A,0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x0A,0x0A,0x1F,0x0A,0x1F,0x0A,0x0A,0x00 },
+    { 0x04,0x0E,0x01,0x0E,0x10,0x0E,0x04,0x00 },
+    { 0x00,0x08,0x09,0x04,0x04,0x12,0x02,0x00 },
+    { 0x0C,0x12,0x02,0x06,0x09,0x14,0x0E,0x00 },
+    { 0x04,0x04,0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x08,0x04,0x04,0x04,0x04,0x04,0x08,0x00 },
+    { 0x04,0x08,0x08,0x08,0x08,0x08,0x04,0x00 },
+    { 0x00,0x0A,0x04,0x0E,0x04,0x0A,0x00,0x00 },
+    { 0x00,0x00,0x04,0x0E,0x04,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x08,0x04 },
+    { 0x00,0x00,0x00,0x0E,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x04 },
+    { 0x00,0x08,0x08,0x04,0x04,0x02,0x02,0x00 },
+    { 0x0E,0x11,0x19,0x15,0x13,0x11,0x0E,0x00 },
+    { 0x08,0x0C,0x08,0x08,0x08,0x08,0x08,0x00 },
+    { 0x0E,0x11,0x10,0x08,0x06,0x01,0x1F,0x00 },
+    { 0x0E,0x11,0x10,0x08,0x10,0x11,0x0E,0x00 },
+    { 0x11,0x11,0x11,0x1F,0x10,0x10,0x10,0x00 },
+    { 0x1E,0x01,0x01,0x0E,0x10,0x11,0x0E,0x00 },
+    { 0x1E,0x01,0x01,0x0F,0x11,0x11,0x0E,0x00 },
+    { 0x1F,0x10,0x10,0x08,0x08,0x04,0x04,0x00 },
+    { 0x0E,0x11,0x11,0x0E,0x11,0x11,0x0E,0x00 },
+    { 0x0E,0x11,0x11,0x1E,0x10,0x10,0x0E,0x00 },
+    { 0x04,0x00,0x00,0x00,0x00,0x00,0x00,0x04 },
+    { 0x04,0x00,0x00,0x00,0x00,0x00,0x08,0x04 },
+    { 0x00,0x18,0x06,0x01,0x06,0x18,0x00,0x00 },
+    { 0x00,0x00,0x1E,0x00,0x1E,0x00,0x00,0x00 },
+    { 0x00,0x03,0x0C,0x10,0x0C,0x03,0x00,0x00 },
+    { 0x0E,0x11,0x10,0x08,0x04,0x04,0x00,0x04 },
+    { 0x0E,0x13,0x19,0x15,0x15,0x19,0x1E,0x20 },
+    { 0x04,0x0A,0x0A,0x0E,0x0A,0x11,0x11,0x00 },
+    { 0x0F,0x11,0x11,0x0F,0x11,0x11,0x0F,0x00 },
+    { 0x0E,0x11,0x01,0x01,0x01,0x11,0x0E,0x00 },
+    { 0x0F,0x11,0x11,0x11,0x11,0x11,0x0F,0x00 },
+    { 0x1F,0x01,0x01,0x0F,0x01,0x01,0x1F,0x00 },
+    { 0x1F,0x01,0x01,0x0F,0x01,0x01,0x01,0x00 },
+    { 0x0E,0x11,0x01,0x01,0x09,0x19,0x0E,0x00 },
+    { 0x11,0x11,0x11,0x1F,0x11,0x11,0x11,0x00 },
+    { 0x1F,0x04,0x04,0x04,0x04,0x04,0x1F,0x00 },
+    { 0x1E,0x05,0x04,0x04,0x04,0x04,0x03,0x00 },
+    { 0x11,0x09,0x05,0x03,0x05,0x09,0x11,0x00 },
+    { 0x01,0x01,0x01,0x01,0x01,0x01,0x1F,0x00 },
+    { 0x1B,0x15,0x15,0x11,0x11,0x11,0x11,0x00 },
+    { 0x13,0x15,0x15,0x15,0x15,0x15,0x19,0x00 },
+    { 0x0E,0x11,0x11,0x11,0x11,0x11,0x0E,0x00 },
+    { 0x0F,0x11,0x11,0x0F,0x01,0x01,0x01,0x00 },
+    { 0x0E,0x11,0x11,0x11,0x11,0x19,0x1E,0x20 },
+    { 0x0F,0x11,0x11,0x0F,0x05,0x09,0x11,0x00 },
+    { 0x1E,0x01,0x01,0x0E,0x10,0x10,0x0F,0x00 },
+    { 0x1F,0x04,0x04,0x04,0x04,0x04,0x04,0x00 },
+    { 0x11,0x11,0x11,0x11,0x11,0x11,0x0E,0x00 },
+    { 0x11,0x11,0x11,0x11,0x0A,0x0A,0x04,0x00 },
+    { 0x11,0x11,0x11,0x15,0x15,0x15,0x0A,0x00 },
+    { 0x11,0x0A,0x0A,0x04,0x0A,0x0A,0x11,0x00 },
+    { 0x11,0x0A,0x0A,0x04,0x04,0x04,0x04,0x00 },
+    { 0x1F,0x10,0x08,0x04,0x02,0x01,0x1F,0x00 },
+    { 0x0C,0x04,0x04,0x04,0x04,0x04,0x0C,0x00 },
+    { 0x00,0x02,0x02,0x04,0x04,0x08,0x08,0x00 },
+    { 0x0C,0x08,0x08,0x08,0x08,0x08,0x0C,0x00 },
+    { 0x04,0x0A,0x0A,0x11,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x1F,0x00 },
+    { 0x02,0x04,0x00,0x00,0x00,0x00,0x00,0x00 },
+    { 0x00,0x06,0x09,0x08,0x0E,0x09,0x1E,0x00 },
+    { 0x02,0x02,0x02,0x0E,0x12,0x12,0x0E,0x00 },
+    { 0x00,0x00,0x0C,0x12,0x02,0x12,0x0C,0x00 },
+    { 0x10,0x10,0x10,0x1C,0x12,0x12,0x1C,0x00 },
+    { 0x00,0x00,0x0C,0x12,0x0E,0x02,0x0C,0x00 },
+    { 0x0C,0x12,0x02,0x0F,0x02,0x02,0x02,0x00 },
+    { 0x00,0x00,0x1E,0x09,0x09,0x0E,0x08,0x06 },
+    { 0x02,0x02,0x02,0x0E,0x12,0x12,0x12,0x00 },
+    { 0x00,0x04,0x00,0x04,0x04,0x04,0x04,0x00 },
+    { 0x00,0x04,0x00,0x06,0x04,0x04,0x04,0x02 },
+    { 0x02,0x02,0x02,0x0A,0x06,0x0A,0x0A,0x00 },
+    { 0x00,0x04,0x04,0x04,0x04,0x06,0x04,0x00 },
+    { 0x00,0x00,0x0F,0x15,0x15,0x15,0x15,0x00 },
+    { 0x00,0x00,0x0E,0x12,0x12,0x12,0x12,0x00 },
+    { 0x00,0x00,0x0E,0x11,0x11,0x11,0x0E,0x00 },
+    { 0x00,0x00,0x0E,0x12,0x12,0x0E,0x02,0x02 },
+    { 0x00,0x00,0x0C,0x12,0x12,0x1C,0x10,0x10 },
+    { 0x00,0x00,0x1A,0x06,0x02,0x02,0x02,0x00 },
+    { 0x00,0x00,0x1C,0x02,0x0C,0x10,0x0E,0x00 },
+    { 0x04,0x04,0x0E,0x04,0x04,0x04,0x04,0x08 },
+    { 0x00,0x00,0x12,0x12,0x12,0x12,0x0C,0x00 },
+    { 0x00,0x00,0x11,0x11,0x0A,0x0A,0x04,0x00 },
+    { 0x00,0x00,0x11,0x11,0x11,0x15,0x0A,0x00 },
+    { 0x00,0x00,0x0A,0x0A,0x04,0x0A,0x0A,0x00 },
+    { 0x00,0x00,0x0A,0x0A,0x0A,0x0C,0x08,0x04 },
+    { 0x00,0x00,0x0E,0x08,0x04,0x02,0x0E,0x00 },
+    { 0x08,0x04,0x04,0x02,0x04,0x04,0x08,0x00 },
+    { 0x00,0x04,0x04,0x04,0x04,0x04,0x04,0x00 },
+    { 0x04,0x08,0x08,0x10,0x08,0x08,0x04,0x00 },
+    { 0x00,0x00,0x00,0x14,0x0A,0x00,0x00,0x00 },
+    { 0x11,0x00,0x22,0x00,0x11,0x00,0x22,0x00 },
+    { 0x15,0x2A,0x15,0x2A,0x15,0x2A,0x15,0x2A },
+    { 0x2E,0x3F,0x1D,0x3F,0x2E,0x3F,0x1D,0x3F },
+    { 0x0C,0x0C,0x0C,0x0C,0x0C,0x0C,0x0C,0x0C },
+    { 0x0C,0x0C,0x0C,0x0F,0x0F,0x0C,0x0C,0x0C },
+    { 0x0C,0x0C,0x0F,0x08,0x08,0x0F,0x0C,0x0C },
+    { 0x12,0x12,0x12,0x13,0x13,0x12,0x12,0x12 },
+    { 0x00,0x00,0x00,0x1F,0x13,0x12,0x12,0x12 },
+    { 0x00,0x00,0x0F,0x08,0x08,0x0F,0x0C,0x0C },
+    { 0x12,0x12,0x13,0x10,0x10,0x13,0x12,0x12 },
+    { 0x12,0x12,0x12,0x12,0x12,0x12,0x12,0x12 },
+    { 0x00,0x00,0x1F,0x10,0x10,0x13,0x12,0x12 },
+    { 0x12,0x12,0x13,0x10,0x10,0x1F,0x00,0x00 },
+    { 0x12,0x12,0x12,0x13,0x1F,0x00,0x00,0x00 },
+    { 0x0C,0x0C,0x0F,0x08,0x08,0x0F,0x00,0x00 },
+    { 0x00,0x00,0x00,0x0F,0x0F,0x0C,0x0C,0x0C },
+    { 0x0C,0x0C,0x0C,0x3C,0x3C,0x00,0x00,0x00 },
+    { 0x0C,0x0C,0x0C,0x3F,0x3F,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x3F,0x3F,0x0C,0x0C,0x0C },
+    { 0x0C,0x0C,0x0C,0x3C,0x3C,0x0C,0x0C,0x0C },
+    { 0x00,0x00,0x00,0x3F,0x3F,0x00,0x00,0x00 },
+    { 0x0C,0x0C,0x0C,0x3F,0x3F,0x0C,0x0C,0x0C },
+    { 0x0C,0x0C,0x3C,0x04,0x04,0x3C,0x0C,0x0C },
+    { 0x12,0x12,0x12,0x32,0x32,0x12,0x12,0x12 },
+    { 0x12,0x12,0x32,0x02,0x02,0x3E,0x00,0x00 },
+    { 0x00,0x00,0x3E,0x02,0x02,0x32,0x12,0x12 },
+    { 0x12,0x12,0x33,0x00,0x00,0x3F,0x00,0x00 },
+    { 0x00,0x00,0x3F,0x00,0x00,0x33,0x12,0x12 },
+    { 0x12,0x12,0x32,0x02,0x02,0x32,0x12,0x12 },
+    { 0x00,0x00,0x3F,0x00,0x00,0x3F,0x00,0x00 },
+    { 0x12,0x12,0x33,0x00,0x00,0x33,0x12,0x12 },
+    { 0x0C,0x0C,0x3F,0x00,0x00,0x3F,0x00,0x00 },
+    { 0x12,0x12,0x12,0x33,0x3F,0x00,0x00,0x00 },
+    { 0x00,0x00,0x3F,0x00,0x00,0x3F,0x0C,0x0C },
+    { 0x00,0x00,0x00,0x3F,0x33,0x12,0x12,0x12 },
+    { 0x12,0x12,0x12,0x32,0x3E,0x00,0x00,0x00 },
+    { 0x0C,0x0C,0x3C,0x04,0x04,0x3C,0x00,0x00 },
+    { 0x00,0x00,0x3C,0x04,0x04,0x3C,0x0C,0x0C },
+    { 0x00,0x00,0x00,0x3E,0x32,0x12,0x12,0x12 },
+    { 0x12,0x12,0x12,0x3F,0x3F,0x12,0x12,0x12 },
+    { 0x0C,0x0C,0x3F,0x0C,0x0C,0x3F,0x0C,0x0C },
+    { 0x0C,0x0C,0x0C,0x0F,0x0F,0x00,0x00,0x00 },
+    { 0x00,0x00,0x00,0x3C,0x3C,0x0C,0x0C,0x0C },
+    { 0x3F,0x3F,0x3F,0x3F,0x3F,0x3F,0x3F,0x3F },
+    { 0x00,0x00,0x00,0x00,0x3F,0x3F,0x3F,0x3F },
+    { 0x07,0x07,0x07,0x07,0x07,0x07,0x07,0x07 },
+    { 0x38,0x38,0x38,0x38,0x38,0x38,0x38,0x38 },
+    { 0x3F,0x3F,0x3F,0x3F,0x00,0x00,0x00,0x00 },
+    { 0x0C,0x12,0x12,0x0C,0x00,0x00,0x00,0x00 },
+    { 0x00,0x00,0x1E,0x1E,0x1E,0x1E,0x00,0x00 },
+    { 0x1B,0x29,0x29,0x1B,0x29,0x29,0x29,0x2B },
+};
+
+#endif /* _FONT_TABLE_H */
@@ -0,0 +1,190 @@
+/* Generated by font/codepage_gen from codepage.ppm ( -layout shifted ). Do not edit. */
+#ifndef _FONT_TABLE_H
+#define _FONT_TABLE_H
+
+#define FONT_CODES                  178
+#define FONT_GLYPHS                 178
+#define FONT_GLYPH_BYTES            9
+
+const uint8_t font[FONT_GLYPHS][FONT_GLYPH_BYTES] PROGMEM = {
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFC },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFC },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFC },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFC },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFC },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFC },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFC },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFC },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFC },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFC },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFC },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFC },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFC },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFC },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFC },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFC },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFC },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFC },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFC },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFC },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFC },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFC },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFC },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFC },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFC },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFC },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFC },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFC },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFC },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFC },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFC },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFC },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0xFC },
+    { 0x20,0x20,0x20,0x20,0x20,0x00,0x20,0x00,0xFC },
+    { 0x50,0x50,0x00,0x00,0x00,0x00,0x00,0x00,0xFC },
+    { 0x50,0x50,0xF8,0x50,0xF8,0x50,0x50,0x00,0xFC },
+    { 0x20,0x70,0x80,0x70,0x08,0x70,0x20,0x00,0xFC },
+    { 0x00,0x10,0x90,0x20,0x20,0x48,0x40,0x00,0xFC },
+    { 0x30,0x48,0x40,0x60,0x90,0x28,0x70,0x00,0xFC },
+    { 0x20,0x20,0x00,0x00,0x00,0x00,0x00,0x00,0xFC },
+    { 0x10,0x20,0x20,0x20,0x20,0x20,0x10,0x00,0xFC },
+    { 0x20,0x10,0x10,0x10,0x10,0x10,0x20,0x00,0xFC },
+    { 0x00,0x50,0x20,0x70,0x20,0x50,0x00,0x00,0xFC },
+    { 0x00,0x00,0x20,0x70,0x20,0x00,0x00,0x00,0xFC },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x10,0x20,0xFC },
+    { 0x00,0x00,0x00,0x70,0x00,0x00,0x00,0x00,0xFC },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x20,0xFC },
+    { 0x00,0x10,0x10,0x20,0x20,0x40,0x40,0x00,0xFC },
+    { 0x70,0x88,0x98,0xA8,0xC8,0x88,0x70,0x00,0xFC },
+    { 0x10,0x30,0x10,0x10,0x10,0x10,0x10,0x00,0xFC },
+    { 0x70,0x88,0x08,0x10,0x60,0x80,0xF8,0x00,0xFC },
+    { 0x70,0x88,0x08,0x10,0x08,0x88,0x70,0x00,0xFC },
+    { 0x88,0x88,0x88,0xF8,0x08,0x08,0x08,0x00,0xFC },
+    { 0x78,0x80,0x80,0x70,0x08,0x88,0x70,0x00,0xFC },
+    { 0x78,0x80,0x80,0xF0,0x88,0x88,0x70,0x00,0xFC },
+    { 0xF8,0x08,0x08,0x10,0x10,0x20,0x20,0x00,0xFC },
+    { 0x70,0x88,0x88,0x70,0x88,0x88,0x70,0x00,0xFC },
+    { 0x70,0x88,0x88,0x78,0x08,0x08,0x70,0x00,0xFC },
+    { 0x20,0x00,0x00,0x00,0x00,0x00,0x00,0x20,0xFC },
+    { 0x20,0x00,0x00,0x00,0x00,0x00,0x10,0x20,0xFC },
+    { 0x00,0x18,0x60,0x80,0x60,0x18,0x00,0x00,0xFC },
+    { 0x00,0x00,0x78,0x00,0x78,0x00,0x00,0x00,0xFC },
+    { 0x00,0xC0,0x30,0x08,0x30,0xC0,0x00,0x00,0xFC },
+    { 0x70,0x88,0x08,0x10,0x20,0x20,0x00,0x20,0xFC },
+    { 0x70,0xC8,0x98,0xA8,0xA8,0x98,0x78,0x04,0xFC },
+    { 0x20,0x50,0x50,0x70,0x50,0x88,0x88,0x00,0xFC },
+    { 0xF0,0x88,0x88,0xF0,0x88,0x88,0xF0,0x00,0xFC },
+    { 0x70,0x88,0x80,0x80,0x80,0x88,0x70,0x00,0xFC },
+    { 0xF0,0x88,0x88,0x88,0x88,0x88,0xF0,0x00,0xFC },
+    { 0xF8,0x80,0x80,0xF0,0x80,0x80,0xF8,0x00,0xFC },
+    { 0xF8,0x80,0x80,0xF0,0x80,0x80,0x80,0x00,0xFC },
+    { 0x70,0x88,0x80,0x80,0x90,0x98,0x70,0x00,0xFC },
+    { 0x88,0x88,0x88,0xF8,0x88,0x88,0x88,0x00,0xFC },
+    { 0xF8,0x20,0x20,0x20,0x20,0x20,0xF8,0x00,0xFC },
+    { 0x78,0xA0,0x20,0x20,0x20,0x20,0xC0,0x00,0xFC },
+    { 0x88,0x90,0xA0,0xC0,0xA0,0x90,0x88,0x00,0xFC },
+    { 0x80,0x80,0x80,0x80,0x80,0x80,0xF8,0x00,0xFC },
+    { 0xD8,0xA8,0xA8,0x88,0x88,0x88,0x88,0x00,0xFC },
+    { 0xC8,0xA8,0xA8,0xA8,0xA8,0xA8,0x98,0x00,0xFC },
+    { 0x70,0x88,0x88,0x88,0x88,0x88,0x70,0x00,0xFC },
+    { 0xF0,0x88,0x88,0xF0,0x80,0x80,0x80,0x00,0xFC },
+    { 0x70,0x88,0x88,0x88,0x88,0x98,0x78,0x04,0xFC },
+    { 0xF0,0x88,0x88,0xF0,0xA0,0x90,0x88,0x00,0xFC },
+    { 0x78,0x80,0x80,0x70,0x08,0x08,0xF0,0x00,0xFC },
+    { 0xF8,0x20,0x20,0x20,0x20,0x20,0x20,0x00,0xFC },
+    { 0x88,0x88,0x88,0x88,0x88,0x88,0x70,0x00,0xFC },
+    { 0x88,0x88,0x88,0x88,0x50,0x50,0x20,0x00,0xFC },
+    { 0x88,0x88,0x88,0xA8,0xA8,0xA8,0x50,0x00,0xFC },
+    { 0x88,0x50,0x50,0x20,0x50,0x50,0x88,0x00,0xFC },
+    { 0x88,0x50,0x50,0x20,0x20,0x20,0x20,0x00,0xFC },
+    { 0xF8,0x08,0x10,0x20,0x40,0x80,0xF8,0x00,0xFC },
+    { 0x30,0x20,0x20,0x20,0x20,0x20,0x30,0x00,0xFC },
+    { 0x00,0x40,0x40,0x20,0x20,0x10,0x10,0x00,0xFC },
+    { 0x30,0x10,0x10,0x10,0x10,0x10,0x30,0x00,0xFC },
+    { 0x20,0x50,0x50,0x88,0x00,0x00,0x00,0x00,0xFC },
+    { 0x00,0x00,0x00,0x00,0x00,0x00,0xF8,0x00,0xFC },
+    { 0x40,0x20,0x00,0x00,0x00,0x00,0x00,0x00,0xFC },
+    { 0x00,0x60,0x90,0x10,0x70,0x90,0x78,0x00,0xFC },
+    { 0x40,0x40,0x40,0x70,0x48,0x48,0x70,0x00,0xFC },
+    { 0x00,0x00,0x30,0x48,0x40,0x48,0x30,0x00,0xFC },
+    { 0x08,0x08,0x08,0x38,0x48,0x48,0x38,0x00,0xFC },
+    { 0x00,0x00,0x30,0x48,0x70,0x40,0x30,0x00,0xFC },
+    { 0x30,0x48,0x40,0xF0,0x40,0x40,0x40,0x00,0xFC },
+    { 0x00,0x00,0x78,0x90,0x90,0x70,0x10,0x60,0xFC },
+    { 0x40,0x40,0x40,0x70,0x48,0x48,0x48,0x00,0xFC },
+    { 0x00,0x20,0x00,0x20,0x20,0x20,0x20,0x00,0xFC },
+    { 0x00,0x20,0x00,0x60,0x20,0x20,0x20,0x40,0xFC },
+    { 0x40,0x40,0x40,0x50,0x60,0x50,0x50,0x00,0xFC },
+    { 0x00,0x20,0x20,0x20,0x20,0x60,0x20,0x00,0xFC },
+    { 0x00,0x00,0xF0,0xA8,0xA8,0xA8,0xA8,0x00,0xFC },
+    { 0x00,0x00,0x70,0x48,0x48,0x48,0x48,0x00,0xFC },
+    { 0x00,0x00,0x70,0x88,0x88,0x88,0x70,0x00,0xFC },
+    { 0x00,0x00,0x70,0x48,0x48,0x70,0x40,0x40,0xFC },
+    { 0x00,0x00,0x30,0x48,0x48,0x38,0x08,0x08,0xFC },
+    { 0x00,0x00,0x58,0x60,0x40,0x40,0x40,0x00,0xFC },
+    { 0x00,0x00,0x38,0x40,0x30,0x08,0x70,0x00,0xFC },
+    { 0x20,0x20,0x70,0x20,0x20,0x20,0x20,0x10,0xFC },
+    { 0x00,0x00,0x48,0x48,0x48,0x48,0x30,0x00,0xFC },
+    { 0x00,0x00,0x88,0x88,0x50,0x50,0x20,0x00,0xFC },
+    { 0x00,0x00,0x88,0x88,0x88,0xA8,0x50,0x00,0xFC },
+    { 0x00,0x00,0x50,0x50,0x20,0x50,0x50,0x00,0xFC },
+    { 0x00,0x00,0x50,0x50,0x50,0x30,0x10,0x20,0xFC },
+    { 0x00,0x00,0x70,0x10,0x20,0x40,0x70,0x00,0xFC },
+    { 0x10,0x20,0x20,0x40,0x20,0x20,0x10,0x00,0xFC },
+    { 0x00,0x20,0x20,0x20,0x20,0x20,0x20,0x00,0xFC },
+    { 0x20,0x10,0x10,0x08,0x10,0x10,0x20,0x00,0xFC },
+    { 0x00,0x00,0x00,0x28,0x50,0x00,0x00,0x00,0xFC },
+    { 0x88,0x00,0x44,0x00,0x88,0x00,0x44,0x00,0xFC },
+    { 0xA8,0x54,0xA8,0x54,0xA8,0x54,0xA8,0x54,0xFC },
+    { 0x74,0xFC,0xB8,0xFC,0x74,0xFC,0xB8,0xFC,0xFC },
+    { 0x30,0x30,0x30,0x30,0x30,0x30,0x30,0x30,0xFC },
+    { 0x30,0x30,0x30,0xF0,0xF0,0x30,0x30,0x30,0xFC },
+    { 0x30,0x30,0xF0,0x10,0x10,0xF0,0x30,0x30,0xFC },
+    { 0x48,0x48,0x48,0xC8,0xC8,0x48,0x48,0x48,0xFC },
+    { 0x00,0x00,0x00,0xF8,0xC8,0x48,0x48,0x48,0xFC },
+    { 0x00,0x00,0xF0,0x10,0x10,0xF0,0x30,0x30,0xFC },
+    { 0x48,0x48,0xC8,0x08,0x08,0xC8,0x48,0x48,0xFC },
+    { 0x48,0x48,0x48,0x48,0x48,0x48,0x48,0x48,0xFC },
+    { 0x00,0x00,0xF8,0x08,0x08,0xC8,0x48,0x48,0xFC },
+    { 0x48,0x48,0xC8,0x08,0x08,0xF8,0x00,0x00,0xFC },
+    { 0x48,0x48,0x48,0xC8,0xF8,0x00,0x00,0x00,0xFC },
+    { 0x30,0x30,0xF0,0x10,0x10,0xF0,0x00,0x00,0xFC },
+    { 0x00,0x00,0x00,0xF0,0xF0,0x30,0x30,0x30,0xFC },
+    { 0x30,0x30,0x30,0x3C,0x3C,0x00,0x00,0x00,0xFC },
+    { 0x30,0x30,0x30,0xFC,0xFC,0x00,0x00,0x00,0xFC },
+    { 0x00,0x00,0x00,0xFC,0xFC,0x30,0x30,0x30,0xFC },
+    { 0x30,0x30,0x30,0x3C,0x3C,0x30,0x30,0x30,0xFC },
+    { 0x00,0x00,0x00,0xFC,0xFC,0x00,0x00,0x00,0xFC },
+    { 0x30,0x30,0x30,0xFC,0xFC,0x30,0x30,0x30,0xFC },
+    { 0x30,0x30,0x3C,0x20,0x20,0x3C,0x30,0x30,0xFC },
+    { 0x48,0x48,0x48,0x4C,0x4C,0x48,0x48,0x48,0xFC },
+    { 0x48,0x48,0x4C,0x40,0x40,0x7C,0x00,0x00,0xFC },
+    { 0x00,0x00,0x7C,0x40,0x40,0x4C,0x48,0x48,0xFC },
+    { 0x48,0x48,0xCC,0x00,0x00,0xFC,0x00,0x00,0xFC },
+    { 0x00,0x00,0xFC,0x00,0x00,0xCC,0x48,0x48,0xFC },
+    { 0x48,0x48,0x4C,0x40,0x40,0x4C,0x48,0x48,0xFC },
+    { 0x00,0x00,0xFC,0x00,0x00,0xFC,0x00,0x00,0xFC },
+    { 0x48,0x48,0xCC,0x00,0x00,0xCC,0x48,0x48,0xFC },
+    { 0x30,0x30,0xFC,0x00,0x00,0xFC,0x00,0x00,0xFC },
+    { 0x48,0x48,0x48,0xCC,0xFC,0x00,0x00,0x00,0xFC },
+    { 0x00,0x00,0xFC,0x00,0x00,0xFC,0x30,0x30,0xFC },
+    { 0x00,0x00,0x00,0xFC,0xCC,0x48,0x48,0x48,0xFC },
+    { 0x48,0x48,0x48,0x4C,0x7C,0x00,0x00,0x00,0xFC },
+    { 0x30,0x30,0x3C,0x20,0x20,0x3C,0x00,0x00,0xFC },
+    { 0x00,0x00,0x3C,0x20,0x20,0x3C,0x30,0x30,0xFC },
+    { 0x00,0x00,0x00,0x7C,0x4C,0x48,0x48,0x48,0xFC },
+    { 0x48,0x48,0x48,0xFC,0xFC,0x48,0x48,0x48,0xFC },
+    { 0x30,0x30,0xFC,0x30,0x30,0xFC,0x30,0x30,0xFC },
+    { 0x30,0x30,0x30,0xF0,0xF0,0x00,0x00,0x00,0xFC },
+    { 0x00,0x00,0x00,0x3C,0x3C,0x30,0x30,0x30,0xFC },
+    { 0xFC,0xFC,0xFC,0xFC,0xFC,0xFC,0xFC,0xFC,0xFC },
+    { 0x00,0x00,0x00,0x00,0xFC,0xFC,0xFC,0xFC,0xFC },
+    { 0xE0,0xE0,0xE0,0xE0,0xE0,0xE0,0xE0,0xE0,0xFC },
+    { 0x1C,0x1C,0x1C,0x1C,0x1C,0x1C,0x1C,0x1C,0xFC },
+    { 0xFC,0xFC,0xFC,0xFC,0x00,0x00,0x00,0x00,0xFC },
+    { 0x30,0x48,0x48,0x30,0x00,0x00,0x00,0x00,0xFC },
+    { 0x00,0x00,0x78,0x78,0x78,0x78,0x00,0x00,0xFC },
+    { 0xD8,0x94,0x94,0xD8,0x94,0x94,0x94,0xD4,0xFC },
+};
+
+#endif /* _FONT_TABLE_H */
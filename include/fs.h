@@ -0,0 +1,89 @@
+#ifndef _FS_H
+#define _FS_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <assert.h>
+
+/* Kept free of AVR headers, so that tools/ can build it on host */
+#define FS_PACKED           __attribute__((packed))
+
+#define FS_MAGIC            0x46534F52UL    /* "ROSF" */
+#define FS_VERSION          1
+
+#define FS_PAGE_SIZE        64              /* Write page of 24LC256 */
+#define FS_PAGES_CAP        (FS_PAGE_SIZE * 8)
+
+#define FS_NAME_CAP         8
+#define FS_EXT_CAP          4
+#define FS_DIR_SLOTS        32
+
+/* Layout: every metadata structure starts on a page boundary */
+#define FS_SUPER_PAGE       0
+#define FS_BITMAP_PAGE      1
+#define FS_DIR_PAGE         2
+#define FS_DIR_PAGES        ((FS_DIR_SLOTS * sizeof(struct FS_Entry)) / FS_PAGE_SIZE)
+#define FS_DATA_PAGE        (FS_DIR_PAGE + FS_DIR_PAGES)
+
+#define FS_SLOT_FREE        0x00
+#define FS_SLOT_DELETED     0xE5
+
+enum FS_Error {
+    FS_OK              =  0,
+    FS_ERROR_IO        = -1,
+    FS_ERROR_NAME      = -2,
+    FS_ERROR_EXISTS    = -3,
+    FS_ERROR_NOT_FOUND = -4,
+    FS_ERROR_DIR_FULL  = -5,
+    FS_ERROR_NO_SPACE  = -6,
+    FS_ERROR_BAD_FS    = -7,
+    FS_ERROR_RANGE     = -8,
+};
+
+/* Anything byte-addressable: EEPROM bus driver, block cache, RAM image */
+struct FS_Device {
+    int (*read)(uint16_t addr, void *buf, uint16_t len);
+    int (*write)(uint16_t addr, const void *buf, uint16_t len);
+    uint16_t pages;
+};
+
+struct FS_PACKED FS_Superblock {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t page_size;
+    uint16_t pages;
+    uint16_t free_pages;
+    uint8_t dir_slots;
+};
+
+/* One contiguous extent per file */
+struct FS_PACKED FS_Entry {
+    char name[FS_NAME_CAP];
+    char ext[FS_EXT_CAP];
+    uint16_t start;         /* First page */
+    uint16_t size;          /* Bytes */
+};
+
+struct FS_File {
+    struct FS_Entry entry;
+    uint8_t slot;
+};
+
+static_assert( FS_PAGE_SIZE % sizeof(struct FS_Entry) == 0 );
+static_assert( sizeof(struct FS_Superblock) <= FS_PAGE_SIZE );
+
+int fs_format(const struct FS_Device *);
+int fs_mount(const struct FS_Device *);
+const struct FS_Superblock *fs_superblock(void);
+
+int fs_open(const char *, struct FS_File *);
+int fs_create(const char *, uint16_t, struct FS_File *);
+int fs_remove(const char *);
+int fs_readdir(uint8_t *, struct FS_Entry *);
+
+int fs_read(const struct FS_File *, uint16_t, void *, uint16_t);
+int fs_write(const struct FS_File *, uint16_t, const void *, uint16_t);
+uint16_t fs_address(const struct FS_File *, uint16_t);
+
+#endif /* _FS_H */
@@ -0,0 +1,28 @@
+#ifndef _HISTORY_H
+#define _HISTORY_H
+
+#include <inttypes.h>
+#include <stdbool.h>
+
+#include "ros.h"
+
+#define HISTORY_RING_CAP        128
+#define HISTORY_ENTRY_CAP       64
+#define HISTORY_MAGIC           0x5248 /* "RH" */
+
+/* Entries are stored as [len][data...] and wrap around the ring */
+struct PACKED History_Ring {
+    uint8_t tail;       /* Oldest entry */
+    uint8_t used;       /* Bytes in use */
+    uint8_t count;      /* Number of entries */
+    uint8_t raw[HISTORY_RING_CAP];
+};
+static_assert( sizeof(uint16_t) + sizeof(struct History_Ring) <= EEPROM_HISTORY_SIZE );
+
+void history_init(void);
+void history_push(const char *, uint8_t);
+int history_recall(uint8_t, char *, uint8_t, uint8_t *);
+uint8_t history_size(void);
+void history_sync(void);
+
+#endif /* _HISTORY_H */
@@ -8,6 +8,13 @@
 #define KEYBOARD_SO_PIN         2
 #define KEYBOARD_INTERRUPT_PIN  2
 
+#ifndef NDEBUG
+    /* Speed-up emulator */
+    #define KEYBOARD_DELAY_MS   0
+#else
+    #define KEYBOARD_DELAY_MS   100
+#endif
+
 #define INVALID_KEY             (enum Virtual_Key)(0xFF)
 
 #define KEY(sym,code)   VK_##sym = code,
@@ -21,6 +28,8 @@ typedef void (*__callback Keyboard_User_Callback)(enum Virtual_Key);
 
 int vk_as_char(enum Virtual_Key key);
 void __driver keyboard_init(Keyboard_User_Callback);
+void keyboard_set_delay(uint8_t);
+void keyboard_idle_poll(void);
 
 extern volatile enum Virtual_Key idle_key;
 
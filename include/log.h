@@ -6,6 +6,10 @@
 #define LOG_TYPES_NUMBER    (LOG_TYPE_CRITICAL + 1)
 #define HARD_ERROR(code)    ros_log(LOG_TYPE_CRITICAL, NULL, (code))
 
+#define LOG_LINE_CAP        32      /* Formatted message, longer ones are cut */
+#define LOG_BURST           5
+#define LOG_REFILL_TICKS    25      /* Scheduler ticks per token */
+
 enum Critical_Code {
     FAULT_DRIVER_KEYBOARD      = 0x00,
     FAULT_KERNEL_BAD_INTERRUPT = 0x10,
@@ -21,5 +25,9 @@ enum Log_Type {
 
 void ros_log(enum Log_Type, const char *, ...)
                                             __attribute__((format(printf, 2, 3)));
+void log_set_level(uint8_t);
+void log_init(void);
+void log_show(enum Log_Type, const char *);
+void log_prompt(void);
 
 #endif /* _LOG_H */
\ No newline at end of file
@@ -0,0 +1,39 @@
+#ifndef _MEMSTAT_H
+#define _MEMSTAT_H
+
+#include <inttypes.h>
+#include <stdbool.h>
+
+#include <avr/io.h>
+
+#include "sched.h"
+#include "ros.h"
+
+#define MEMSTAT_CANARY          0xC5
+#define MEMSTAT_WINDOW          256     /* Repainted below scheduler frame around each task run, depth saturates here */
+#define MEMSTAT_HEADROOM_WARN   128
+#define MEMSTAT_CHECK_TICKS     100
+
+enum Memstat_Isr {
+    MEMSTAT_ISR_INT0 = 0,
+    MEMSTAT_ISR_TIMER0,
+    MEMSTAT_ISR_TWI,
+    MEMSTAT_ISRS_NUMBER
+};
+
+/* Lowest SP seen at ISR entry: depth of whatever was interrupted, nesting included */
+#define MEMSTAT_ISR_ENTER(isr)                  \
+do {                                            \
+    const uint16_t _sp = SP;                    \
+    if (_sp < memstat_isr_sp[(isr)])            \
+        memstat_isr_sp[(isr)] = _sp;            \
+} while( 0 )                                    \
+
+extern volatile uint16_t memstat_isr_sp[MEMSTAT_ISRS_NUMBER];
+
+void memstat_init(void);
+void memstat_task_enter(void);
+void memstat_task_leave(uint8_t);
+uint16_t memstat_headroom(void);
+
+#endif /* _MEMSTAT_H */
@@ -0,0 +1,56 @@
+#ifndef _POOL_H
+#define _POOL_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <assert.h>
+
+/* Kept free of ros.h, bcache draws from pools in tools/ builds too */
+#ifdef __AVR__
+    #include <util/atomic.h>
+    #define POOL_ATOMIC()       ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+#else
+    #define POOL_ATOMIC()
+#endif
+
+#define POOL_BLOCKS_CAP         16      /* One bitmap word per pool */
+#define POOL_END                0xFF
+
+typedef void (*Pool_Reclaim)(void);
+
+#define POOL(name, size, count, reclaim) POOL_##name,
+enum Pool_Id {
+    #include "pool.def"
+    POOLS_NUMBER
+};
+#undef POOL
+
+#define POOL(name, size, count, reclaim) POOL_BLOCK_SIZE_##name = (size),
+enum Pool_Block_Size {
+    #include "pool.def"
+};
+#undef POOL
+
+#define POOL_BLOCK_SIZE(name)   POOL_BLOCK_SIZE_##name
+
+struct __attribute__((packed)) Pool {
+    uint8_t *storage;
+    uint16_t bitmap;            /* Set bit = block in use */
+    uint8_t block_size;
+    uint8_t count;
+    uint8_t used;
+    uint8_t high_water;
+    uint8_t failures;
+    Pool_Reclaim reclaim;       /* Gives cached blocks back, task context only */
+};
+
+void *pool_alloc(enum Pool_Id);
+void pool_free(enum Pool_Id, void *);
+void pool_reclaim(enum Pool_Id);
+
+uint8_t pool_next(enum Pool_Id, uint8_t);
+void *pool_block(enum Pool_Id, uint8_t);
+const struct Pool *pool_info(enum Pool_Id);
+
+#endif /* _POOL_H */
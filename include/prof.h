@@ -0,0 +1,38 @@
+#ifndef _PROF_H
+#define _PROF_H
+
+#include <inttypes.h>
+#include <stdbool.h>
+
+#include "ros.h"
+
+/* Build with 'make PROFILE=1', otherwise probes compile to nothing */
+#define PROF_CYCLES_PER_US      (F_CPU / 1000000UL)
+
+#define PROBE(name) PROF_PROBE_##name,
+enum Prof_Probe {
+    #include "prof.def"
+    PROF_PROBES_NUMBER
+};
+#undef PROBE
+
+struct PACKED Prof_Counter {
+    uint32_t total;
+    uint32_t min, max;
+    uint16_t count;
+};
+
+#ifdef PROFILE
+    #define PROF_BEGIN(probe)   const uint32_t _prof_##probe = prof_now()
+    #define PROF_END(probe)     prof_account(PROF_PROBE_##probe, _prof_##probe)
+#else
+    #define PROF_BEGIN(probe)   do { } while( 0 )
+    #define PROF_END(probe)     do { } while( 0 )
+#endif
+
+void prof_init(void);
+uint32_t prof_now(void);
+void prof_account(enum Prof_Probe, uint32_t);
+void prof_reset(void);
+
+#endif /* _PROF_H */
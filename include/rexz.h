@@ -0,0 +1,23 @@
+#ifndef _REXZ_H
+#define _REXZ_H
+
+#include <inttypes.h>
+#include <assert.h>
+
+/* Compressed .rex ( asm -compress ), shared with asm/, so no AVR headers here.
+   Header is followed by LZSS groups: flag byte, LSB first, then 8 items -
+   1: literal byte, 0: match of ( distance - 1, length - REXZ_MATCH_MIN ) */
+#define REXZ_MAGIC              "REXZ"
+#define REXZ_WINDOW             256     /* Decoder reads it back from unpacked CHIP-8 memory */
+#define REXZ_MATCH_MIN          3
+#define REXZ_MATCH_MAX          (REXZ_MATCH_MIN + 255)
+
+/* 'R' 'E' is SE V2, V4 with nonzero low nibble, no raw image starts with it */
+struct __attribute__((packed)) Rexz_Header {
+    char magic[4];
+    uint16_t size;                      /* Unpacked, little-endian */
+};
+
+static_assert( sizeof(struct Rexz_Header) == 6 );
+
+#endif /* _REXZ_H */
@@ -0,0 +1,14 @@
+#ifndef _RLE_H
+#define _RLE_H
+
+/* ros_puts_rle_P() stream, shared with tools/rlegen, so no AVR headers here.
+   Header byte and its count in low 7 bits:
+     RLE_RUN | n, ch        - n copies of ch
+     n, ch1 ... chn         - n characters as is
+     0, attrib              - attribute of what follows ( ATTRIBUTE_DEFAULT at start )
+     RLE_END                - end of stream */
+#define RLE_RUN             0x80
+#define RLE_END             RLE_RUN
+#define RLE_COUNT_MAX       0x7F
+
+#endif /* _RLE_H */
@@ -26,17 +26,27 @@
 
 #define INPUT_BUFFER_CAP    260
 
+/* Gap buffer: text is raw[0, gap_begin) + raw[gap_end, INPUT_BUFFER_CAP) */
+/* Cursor always sits at gap_begin, so insert\delete at cursor is O(1) */
 struct Input_Buffer {
-    unsigned short cursor;
+    unsigned short gap_begin;
+    unsigned short gap_end;
     char raw[INPUT_BUFFER_CAP];
 };
 
+#define INPUT_BUFFER_LENGTH(b)      ((b).gap_begin + (INPUT_BUFFER_CAP - (b).gap_end))
+#define INPUT_BUFFER_AT(b, i)       (((i) < (b).gap_begin) ? (b).raw[(i)] : (b).raw[(i) + ((b).gap_end - (b).gap_begin)])
+#define INPUT_BUFFER_UNDER(b)       (((b).gap_end < INPUT_BUFFER_CAP) ? (b).raw[(b).gap_end] : '\0')
+
 extern enum System_Mode {
     SYSTEM_MODE_INPUT = 0,  /* Command mode\Listening to input */
     SYSTEM_MODE_BUSY,       /* System is busy and doesn't listen any input */
     SYSTEM_MODE_IDLE,       /* System is waiting for any key to press */
 } sys_mode;
 
+extern int ros_wait_key(void);
+extern void ros_pause(void);
+
 /* --------------- Attributes --------------- */
 #define PACKED              __attribute__((packed))
 #define NOINLINE            __attribute__((noinline))
@@ -50,6 +60,12 @@ extern enum System_Mode {
 #define SCREEN_WIDTH        (128 - 1)
 #define SCREEN_HEIGHT       (160 - 1)
 
+/* --------------- Internal EEPROM --------------- */
+#define EEPROM_HISTORY_BASE     0x000
+#define EEPROM_HISTORY_SIZE     0x100
+#define EEPROM_CONFIG_BASE      0x100
+#define EEPROM_CONFIG_SIZE      0x300
+
 /* --------------- Ports --------------- */
 enum Pin_Direction {
     PIN_DIRECTION_INPUT = 0,
@@ -0,0 +1,53 @@
+#ifndef _SCHED_H
+#define _SCHED_H
+
+#include <inttypes.h>
+#include <stdbool.h>
+
+#include "ros.h"
+
+#define SCHED_TASKS_CAP         8
+#define SCHED_TICK_MS           10      /* TIMER0 compare period */
+
+/* Protothread-style tasks: all tasks share one stack, */
+/* so locals do not survive TASK_* points, use statics instead */
+enum Task_State {
+    TASK_STATE_READY = 0,
+    TASK_STATE_SLEEPING,
+    TASK_STATE_WAITING,
+    TASK_STATE_DONE,
+};
+
+enum Sched_Event {
+    SCHED_EVENT_TICK     = BIT(0),
+    SCHED_EVENT_WORK     = BIT(1),
+};
+
+struct Task;
+typedef void (*__callback Task_Routine)(struct Task *self);
+
+struct PACKED Task {
+    Task_Routine routine;
+    uint16_t line;          /* Resume point */
+    uint16_t wake_tick;
+    uint8_t events;         /* Awaited events, then events which woke the task */
+    uint8_t state;
+};
+
+#define TASK_BEGIN(t)               switch ((t)->line) { case 0:
+#define TASK_END(t)                 } (t)->state = TASK_STATE_DONE; return
+
+#define TASK_YIELD(t)               do { (t)->line = __LINE__; return; case __LINE__:; } while( 0 )
+#define TASK_SLEEP(t, ticks)        do { sched_sleep((t), (ticks)); (t)->line = __LINE__; return; case __LINE__:; } while( 0 )
+#define TASK_WAIT_EVENT(t, ev)      do { sched_wait((t), (ev)); (t)->line = __LINE__; return; case __LINE__:; } while( 0 )
+#define TASK_WAIT_UNTIL(t, cond)    do { (t)->line = __LINE__; case __LINE__: if (!(cond)) return; } while( 0 )
+
+struct Task *sched_spawn(Task_Routine);
+void sched_sleep(struct Task *, uint16_t);
+void sched_wait(struct Task *, uint8_t);
+void sched_signal(uint8_t);
+void sched_tick(void);
+uint16_t sched_now(void);
+void __attribute__((noreturn)) sched_run(void);
+
+#endif /* _SCHED_H */
@@ -0,0 +1,27 @@
+#ifndef _SHELL_H
+#define _SHELL_H
+
+#include <inttypes.h>
+#include <stdbool.h>
+
+#include "shell_hash.h"
+#include "ros.h"
+
+typedef int (*Shell_Handler)(uint8_t argc, char **argv);
+
+struct PACKED Shell_Command {
+    char name[SHELL_NAME_CAP];
+    Shell_Handler handler;
+    uint8_t min_args, max_args;
+    const char *help;           /* PROGMEM */
+};
+
+#define CMD(name, min, max, help)   int shell_cmd_##name(uint8_t, char **);
+#include "commands.def"
+#undef CMD
+
+int shell_execute(char *);
+int shell_complete(const char *, uint8_t, char *, uint8_t);
+void shell_list_matches(const char *, uint8_t);
+
+#endif /* _SHELL_H */
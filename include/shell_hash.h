@@ -0,0 +1,20 @@
+#ifndef _SHELL_HASH_H
+#define _SHELL_HASH_H
+
+#include <inttypes.h>
+
+/* Shared by kernel and tools/shell_gen, must stay host-compilable */
+#define SHELL_NAME_CAP      8
+#define SHELL_ARGS_CAP      8
+
+/* FNV-1a style, folded so that low bits depend on the whole name and seed */
+static inline uint16_t shell_hash(const char *name, uint8_t len, uint8_t seed) {
+    uint16_t h = 0x811C ^ (seed * 0x0101u);
+
+    while (len --)
+        h = (h ^ (uint8_t)*name++) * 0x0193u;
+
+    return h ^ (h >> 8);
+}
+
+#endif /* _SHELL_HASH_H */
@@ -0,0 +1,62 @@
+/* Generated by tools/shell_gen from include/commands.def. Do not edit. */
+#ifndef _SHELL_TABLE_H
+#define _SHELL_TABLE_H
+
+#define SHELL_COMMANDS_NUMBER   22
+#define SHELL_HASH_BUCKETS      11
+
+static const char shell_help_help[] PROGMEM = "List commands or show command usage";
+static const char shell_help_clear[] PROGMEM = "Clear screen";
+static const char shell_help_echo[] PROGMEM = "Print arguments";
+static const char shell_help_history[] PROGMEM = "Show command history";
+static const char shell_help_irq[] PROGMEM = "Worst interrupt-disabled time";
+static const char shell_help_ls[] PROGMEM = "List files";
+static const char shell_help_cat[] PROGMEM = "Print file";
+static const char shell_help_rm[] PROGMEM = "Remove file";
+static const char shell_help_mkfs[] PROGMEM = "Format external EEPROM";
+static const char shell_help_load[] PROGMEM = "Receive file over UART from tools/rexsend";
+static const char shell_help_exec[] PROGMEM = "Run native program: exec <file.rnx> [args]";
+static const char shell_help_run[] PROGMEM = "Run CHIP-8 program: run <file.rex> [args]";
+static const char shell_help_cache[] PROGMEM = "Flush block cache, show stats";
+static const char shell_help_cfg[] PROGMEM = "Show or set config: cfg [key [value]]";
+static const char shell_help_xram[] PROGMEM = "External SRAM usage";
+static const char shell_help_c8mem[] PROGMEM = "CHIP-8 page cache stats";
+static const char shell_help_c8bench[] PROGMEM = "CHIP-8 interpreter speed";
+static const char shell_help_pool[] PROGMEM = "Memory pool usage";
+static const char shell_help_mem[] PROGMEM = "Memory map & stack watermarks";
+static const char shell_help_uart[] PROGMEM = "Console stats, mirror: uart [on|off]";
+static const char shell_help_prof[] PROGMEM = "Profiling counters: prof [reset]";
+static const char shell_help_trace[] PROGMEM = "Dump event trace to UART: trace [clear]";
+
+static const uint8_t shell_hash_displace[SHELL_HASH_BUCKETS] PROGMEM = { 27, 2, 10, 13, 2, 1, 1, 2, 2, 1, 67 };
+
+/* Indexed by hash slot */
+static const struct Shell_Command shell_commands[SHELL_COMMANDS_NUMBER] PROGMEM = {
+    { "load", shell_cmd_load, 0, 0, shell_help_load },
+    { "irq", shell_cmd_irq, 0, 0, shell_help_irq },
+    { "cache", shell_cmd_cache, 0, 0, shell_help_cache },
+    { "xram", shell_cmd_xram, 0, 0, shell_help_xram },
+    { "prof", shell_cmd_prof, 0, 1, shell_help_prof },
+    { "c8mem", shell_cmd_c8mem, 0, 0, shell_help_c8mem },
+    { "exec", shell_cmd_exec, 1, SHELL_ARGS_CAP - 1, shell_help_exec },
+    { "cfg", shell_cmd_cfg, 0, 2, shell_help_cfg },
+    { "pool", shell_cmd_pool, 0, 0, shell_help_pool },
+    { "ls", shell_cmd_ls, 0, 0, shell_help_ls },
+    { "trace", shell_cmd_trace, 0, 1, shell_help_trace },
+    { "cat", shell_cmd_cat, 1, 1, shell_help_cat },
+    { "run", shell_cmd_run, 1, SHELL_ARGS_CAP - 1, shell_help_run },
+    { "history", shell_cmd_history, 0, 0, shell_help_history },
+    { "help", shell_cmd_help, 0, 1, shell_help_help },
+    { "uart", shell_cmd_uart, 0, 1, shell_help_uart },
+    { "mkfs", shell_cmd_mkfs, 0, 0, shell_help_mkfs },
+    { "clear", shell_cmd_clear, 0, 0, shell_help_clear },
+    { "echo", shell_cmd_echo, 0, SHELL_ARGS_CAP - 1, shell_help_echo },
+    { "rm", shell_cmd_rm, 1, 1, shell_help_rm },
+    { "mem", shell_cmd_mem, 0, 0, shell_help_mem },
+    { "c8bench", shell_cmd_c8bench, 0, 0, shell_help_c8bench },
+};
+
+/* Hash slots sorted by name, for prefix completion */
+static const uint8_t shell_prefix_index[SHELL_COMMANDS_NUMBER] PROGMEM = { 21, 5, 2, 11, 7, 17, 18, 6, 14, 13, 1, 0, 9, 20, 16, 8, 4, 19, 12, 10, 15, 3 };
+
+#endif /* _SHELL_TABLE_H */
@@ -8,8 +8,18 @@
 
 #define SPI_SS_PIN      2
 #define SPI_MOSI_PIN    3
+#define SPI_MISO_PIN    4
 #define SPI_SCK_PIN     5
 
+/* Display owns the bus by default, its CS is the hardware SS pin */
+#define SPI_DISPLAY_CS_PIN  SPI_SS_PIN
+#define SPI_SRAM_CS_PIN     0
+
+enum SPI_Slave {
+    SPI_SLAVE_DISPLAY = 0,      /* Mode 1 */
+    SPI_SLAVE_SRAM,             /* Mode 0 */
+};
+
 struct PACKED SPI_Device {
     volatile uint8_t rSPCR;
     volatile uint8_t rSPSR;
@@ -24,5 +34,9 @@ void __driver spi_device_deinit(void);
 
 void __driver spi_device_transfer_byte(const uint8_t ch);
 void __driver spi_device_transfer_buffer(const uint8_t *buffer, unsigned short buffer_size);
+uint8_t __driver spi_device_exchange_byte(const uint8_t ch);
+
+void __driver spi_device_select(enum SPI_Slave slave);
+void __driver spi_device_release(void);
 
 #endif /* _SPI_H */
\ No newline at end of file
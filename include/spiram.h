@@ -0,0 +1,23 @@
+#ifndef _SPIRAM_H
+#define _SPIRAM_H
+
+#include <inttypes.h>
+#include <stdbool.h>
+
+#include "ros.h"
+
+/* 23LC512: 64 KB, 16-bit addressing, sequential mode wraps at end of array */
+#define SPIRAM_SIZE             0x10000UL
+
+#define SPIRAM_CMD_READ         0x03
+#define SPIRAM_CMD_WRITE        0x02
+#define SPIRAM_CMD_RDMR         0x05
+#define SPIRAM_CMD_WRMR         0x01
+
+#define SPIRAM_MODE_SEQUENTIAL  0x40
+
+bool __driver spiram_init(void);
+void __driver spiram_read(uint16_t, void *, uint16_t);
+void __driver spiram_write(uint16_t, const void *, uint16_t);
+
+#endif /* _SPIRAM_H */
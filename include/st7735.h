@@ -2,11 +2,12 @@
 #define _ST7735_H
 
 #include <stddef.h>
+#include <stdbool.h>
 #include <avr/io.h>
 
 #include "ros.h"
 
-#define ST7735_MAX_ARGS     24
+#define ST7735_MAX_ARGS     4       /* Init sequence is a PROGMEM stream, see st7735.c */
 #define ST7735_DC_PIN       1
 
 enum ST7735_Command_Type {
@@ -72,10 +73,11 @@ typedef struct ST7735_Command {
     unsigned short nargs;
 
     uint8_t args[ST7735_MAX_ARGS];
-    uint8_t delay_after;
 } ST7735_Command;
 
 void __driver st7735_init(void);
+bool __driver st7735_poll(void);
+void __driver st7735_wait(void);
 void __driver st7735_set_window(uint8_t, uint8_t, uint8_t, uint8_t);
 void __driver st7735_freeze(void);
 void __driver st7735_unfreeze(void);
@@ -0,0 +1,46 @@
+#ifndef _TRACE_H
+#define _TRACE_H
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <assert.h>
+
+/* Kept free of AVR headers, tools/tracedec.c decodes the same records on host */
+#define TRACE_RING_CAP          64      /* Power of 2 */
+#define TRACE_TIME_UNIT_US      64      /* One TIMER0 count at F_CPU / 1024 */
+#define TRACE_MAGIC             "RTRC"
+
+#define EVENT(name, phase, label, lane) TRACE_##name,
+enum Trace_Event {
+    #include "trace.def"
+    TRACE_EVENTS_NUMBER
+};
+#undef EVENT
+
+/* Time is 16-bit, decoder unwraps it assuming gaps below ~4 s */
+struct __attribute__((packed)) Trace_Record {
+    uint8_t id;
+    uint8_t arg;
+    uint16_t time;
+};
+static_assert( sizeof(struct Trace_Record) == 4 );
+
+/* Dump over UART: header, then 'count' records from oldest to newest */
+struct __attribute__((packed)) Trace_Header {
+    char magic[4];
+    uint8_t count;
+    uint8_t lost;                       /* Overwritten before dump, saturates */
+    uint16_t unit_us;
+};
+
+/* Build with 'make TRACE=1', otherwise hooks compile to nothing */
+#ifdef TRACE
+    #define TRACE_EVENT(ev, arg)    trace_event(TRACE_##ev, (uint8_t)(arg))
+#else
+    #define TRACE_EVENT(ev, arg)    do { } while( 0 )
+#endif
+
+void trace_event(enum Trace_Event, uint8_t);
+void trace_clear(void);
+
+#endif /* _TRACE_H */
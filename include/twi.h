@@ -0,0 +1,46 @@
+#ifndef _TWI_H
+#define _TWI_H
+
+#include <inttypes.h>
+#include <stdbool.h>
+
+/* Kept free of AVR headers, host tools include it next to tools/twi_sim.c */
+#define TWI_FREQUENCY       400000UL
+#define TWI_QUEUE_CAP       4           /* Power of 2, one slot is always free */
+#define TWI_POLL_LIMIT      1000        /* ~25 ms of address retries at 400 kHz */
+
+#define TWI_SDA_PIN         4
+#define TWI_SCL_PIN         5
+
+enum TWI_Status {
+    TWI_STATUS_PENDING = 0,
+    TWI_STATUS_DONE,
+    TWI_STATUS_NACK,
+    TWI_STATUS_ERROR,
+};
+
+enum TWI_Flag {
+    /* Slave NACKs its address while busy ( EEPROM write cycle ): retry instead of failing */
+    TWI_FLAG_ACK_POLL = (1 << 0),
+};
+
+/* Write header + tx, then ( if rx_len ) repeated START and read rx */
+struct TWI_Transaction {
+    uint8_t address;                /* 7-bit */
+    uint8_t flags;
+
+    const uint8_t *header;
+    uint8_t header_len;
+    const uint8_t *tx;
+    uint16_t tx_len;
+    uint8_t *rx;
+    uint16_t rx_len;
+
+    volatile uint8_t status;
+};
+
+void twi_init(void);
+bool twi_submit(struct TWI_Transaction *);
+int twi_wait(struct TWI_Transaction *);
+
+#endif /* _TWI_H */
@@ -0,0 +1,32 @@
+#ifndef _UART_H
+#define _UART_H
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include "ros.h"
+
+/* Double speed mode, 250000 divides 16 MHz exactly ( UBRR = 7 ) */
+#define UART_BAUD       250000UL
+#define UART_UBRR       ((F_CPU / (8UL * UART_BAUD)) - 1)
+
+#define UART_TX_CAP     64      /* Power of 2 */
+#define UART_RX_CAP     32      /* Power of 2 */
+
+typedef void (*__callback Uart_Input_Callback)(char);
+
+struct PACKED Uart_Stats {
+    uint16_t tx, rx;
+    uint8_t overruns;           /* RX ring full or hardware data overrun */
+    uint8_t tx_drops;           /* TX ring full with interrupts disabled */
+};
+
+extern bool uart_mirror_enabled;
+
+void __driver uart_init(Uart_Input_Callback);
+void __driver uart_putc(uint8_t);
+void __driver uart_write(const void *, uint16_t);
+void __driver uart_mirror(uint8_t);
+int __driver uart_getc(void);
+struct Uart_Stats uart_stats(void);
+
+#endif /* _UART_H */
@@ -6,6 +6,7 @@
 #include <stdarg.h>
 #include <assert.h>
 
+#include "rle.h"
 #include "ros.h"
 
 #define TIMER0_PRESCALER    1024
@@ -70,15 +71,21 @@ void ros_graphic_timer_init(void);
 unsigned char ros_putchar(uint8_t, const unsigned char);
 int ros_puts(uint8_t, const unsigned char *, bool);
 int ros_puts_P(uint8_t, const unsigned char *, bool);
+int ros_puts_rle_P(const uint8_t *, bool);
+int ros_puts_2x(uint8_t, const unsigned char *, bool);
 int ros_vprintf(uint8_t, const char *, va_list);
 int ros_printf(uint8_t, const char *, ...) __attribute__((format(printf, 2, 3)));
 int ros_puts_R(const struct Running_String_Info * const);
 void ros_flash(Flash_Routine);
+void ros_mirror_puts(const char *);
 
 /* --------------- Misc --------------- */
 void ros_put_input_buffer(unsigned short, int);
+void ros_put_input_char(unsigned short);
+void ros_put_input_newline(void);
 void ros_put_prompt(void);
 void clear_screen(uint16_t);
+void ros_move_cursor(uint8_t, uint8_t);
 void enable_cursor(void);
 void disable_cursor(void);
 
@@ -0,0 +1,41 @@
+#ifndef _XMODEM_H
+#define _XMODEM_H
+
+#include <inttypes.h>
+
+/* Kept free of ros.h, tools/rexsend.c speaks the same protocol */
+#define XMODEM_SOH              0x01
+#define XMODEM_EOT              0x04
+#define XMODEM_ACK              0x06
+#define XMODEM_NAK              0x15
+#define XMODEM_CAN              0x18
+#define XMODEM_READY            'C'     /* Receiver waits for CRC mode transfer */
+
+/* Frame: SOH, seq, ~seq, block, CRC-16 ( big endian ). One block is one EEPROM page */
+#define XMODEM_BLOCK_SIZE       64
+#define XMODEM_FRAME_SIZE       (XMODEM_BLOCK_SIZE + 5)
+
+/* Block 0 is header: "NAME.EXT", NUL, uint16_t size ( little endian ) */
+#define XMODEM_NAME_CAP         13
+
+/* Frames sent ahead of first unacknowledged one, every frame gets exactly one ACK or NAK */
+#define XMODEM_WINDOW           2
+#define XMODEM_RETRIES          10
+
+/* Receiver timeouts, in milliseconds */
+#define XMODEM_READY_MS         1000    /* 'C' repeat period until first frame */
+#define XMODEM_BYTE_MS          100     /* Silence inside frame, frame is dropped */
+
+#ifdef __AVR__
+    #include <util/crc16.h>
+    #define xmodem_crc_update(crc, data)    _crc_xmodem_update((crc), (data))
+#else
+    static inline uint16_t xmodem_crc_update(uint16_t crc, uint8_t data) {
+        crc ^= (uint16_t)data << 8;
+        for (uint8_t i = 0; i < 8; i++)
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        return crc;
+    }
+#endif
+
+#endif /* _XMODEM_H */
@@ -0,0 +1,30 @@
+#ifndef _XRAM_H
+#define _XRAM_H
+
+#include <inttypes.h>
+#include <stdbool.h>
+
+#include "ros.h"
+
+#define XRAM_HANDLES_CAP        16
+#define XRAM_NULL               0xFF
+#define XRAM_MOVE_CHUNK         32      /* Bounce buffer of compaction */
+
+typedef uint8_t Xram_Handle;
+
+/* Blocks move during compaction, so users keep handles, never addresses */
+struct PACKED Xram_Block {
+    uint16_t addr;
+    uint16_t size;              /* 0 = handle is free */
+};
+
+void xram_init(uint32_t);
+Xram_Handle xram_alloc(uint16_t);
+void xram_free(Xram_Handle);
+uint16_t xram_size(Xram_Handle);
+uint32_t xram_available(void);
+
+int xram_read(Xram_Handle, uint16_t, void *, uint16_t);
+int xram_write(Xram_Handle, uint16_t, const void *, uint16_t);
+
+#endif /* _XRAM_H */
@@ -0,0 +1,248 @@
+#include <stddef.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <string.h>
+
+#include "bcache.h"
+#include "pool.h"
+#include "fs.h"
+
+#define PAGE_OF(addr)       ((uint16_t)((addr) / BCACHE_LINE_SIZE))
+#define PAGE_ADDR(p)        ((uint16_t)((p) * BCACHE_LINE_SIZE))
+
+static const struct FS_Device *backing = NULL;
+/* Lines come from the page pool on demand and go back on bcache_trim() */
+static_assert( sizeof(struct Bcache_Line) <= POOL_BLOCK_SIZE(page) );
+
+static struct Bcache_Line *lines[BCACHE_LINES_CAP];
+static uint8_t lru[BCACHE_LINES_CAP];   /* Line indices, most recent first */
+static uint8_t count = 0;
+static uint16_t last_miss = BCACHE_NO_PAGE;
+static struct Bcache_Stats stats = { 0 };
+
+struct FS_Device bcache_device = {
+    .read = bcache_read,
+    .write = bcache_write,
+    .pages = 0
+};
+
+void bcache_init(const struct FS_Device *dev) {
+    backing = dev;
+    bcache_device.pages = dev->pages;
+    last_miss = BCACHE_NO_PAGE;
+
+    while (count > 0)
+        pool_free(POOL_page, lines[--count]);
+}
+
+const struct Bcache_Stats *bcache_stats(void) {
+    return &stats;
+}
+
+static void bcache_touch(uint8_t line) {
+    uint8_t i = 0;
+
+    while (lru[i] != line)
+        i++;
+
+    for (; i > 0; i--)
+        lru[i] = lru[i - 1];
+
+    lru[0] = line;
+}
+
+static int bcache_find(uint16_t page) {
+    for (uint8_t i = 0; i < count; i++)
+        if ((lines[i]->flags & BCACHE_FLAG_VALID) && (lines[i]->page == page))
+            return i;
+
+    return -1;
+}
+
+static int bcache_writeback(struct Bcache_Line *line) {
+    if (!(line->flags & BCACHE_FLAG_DIRTY))
+        return 0;
+
+    if (backing->write(PAGE_ADDR(line->page), line->data, BCACHE_LINE_SIZE) < 0)
+        return -1;
+
+    line->flags &= (uint8_t)~BCACHE_FLAG_DIRTY;
+    stats.writebacks ++;
+    return 0;
+}
+
+/* Fresh line while pool has spare blocks, otherwise least recently used one, cleaned */
+static int bcache_evict(void) {
+    struct Bcache_Line *line;
+    uint8_t victim;
+
+    if ((count < BCACHE_LINES_CAP) && (line = pool_alloc(POOL_page))) {
+        victim = count;
+        lines[count] = line;
+        lru[count++] = victim;
+    } else if (count > 0) {
+        victim = lru[count - 1];
+        if (bcache_writeback(lines[victim]) < 0)
+            return -1;
+    } else
+        return -1;
+
+    lines[victim]->flags = 0;
+    lines[victim]->page = BCACHE_NO_PAGE;
+    return victim;
+}
+
+static int bcache_fill(uint16_t page, bool load) {
+    int line;
+
+    if ((line = bcache_evict()) < 0)
+        return -1;
+
+    if (load && (backing->read(PAGE_ADDR(page), lines[line]->data, BCACHE_LINE_SIZE) < 0))
+        return -1;
+
+    lines[line]->page = page;
+    lines[line]->flags = BCACHE_FLAG_VALID;
+    return line;
+}
+
+/* Returns line holding the page, load = false skips reading page that is about to be overwritten */
+static int bcache_get(uint16_t page, bool load) {
+    int line;
+
+    if ((line = bcache_find(page)) >= 0) {
+        stats.hits ++;
+        bcache_touch((uint8_t)line);
+        return line;
+    }
+
+    stats.misses ++;
+    if ((line = bcache_fill(page, load)) < 0)
+        return -1;
+
+    bcache_touch((uint8_t)line);
+
+    /* Streaming reader: next page is very likely to be wanted, keep demand line most recent */
+    if (load && (page == (uint16_t)(last_miss + 1)) && (page + 1u < backing->pages) && (bcache_find(page + 1) < 0)) {
+        int ahead = bcache_fill(page + 1, true);
+
+        if (ahead >= 0) {
+            stats.readahead ++;
+            bcache_touch((uint8_t)ahead);
+            bcache_touch((uint8_t)line);
+        }
+    }
+
+    last_miss = page;
+    return line;
+}
+
+/* Whole uncached pages go straight from device to caller in one sequential read */
+static bool bcache_bypass(uint16_t addr, uint16_t len) {
+    return !(addr % BCACHE_LINE_SIZE) && (len >= BCACHE_LINE_SIZE) && (bcache_find(PAGE_OF(addr)) < 0);
+}
+
+int bcache_read(uint16_t addr, void *buf, uint16_t len) {
+    uint8_t *dst = buf;
+    const uint16_t total = len;
+
+    while (len > 0) {
+        uint16_t chunk;
+        int line;
+
+        if (bcache_bypass(addr, len)) {
+            chunk = len - (len % BCACHE_LINE_SIZE);
+
+            /* Stop before the first cached page, it may hold newer data */
+            for (uint16_t p = 1; p < chunk / BCACHE_LINE_SIZE; p++)
+                if (bcache_find(PAGE_OF(addr) + p) >= 0) {
+                    chunk = p * BCACHE_LINE_SIZE;
+                    break;
+                }
+
+            if (backing->read(addr, dst, chunk) < 0)
+                return -1;
+
+            stats.bypass += chunk / BCACHE_LINE_SIZE;
+        } else {
+            const uint16_t offset = addr % BCACHE_LINE_SIZE;
+
+            chunk = BCACHE_LINE_SIZE - offset;
+            if (chunk > len)
+                chunk = len;
+
+            if ((line = bcache_get(PAGE_OF(addr), true)) < 0)
+                return -1;
+
+            memcpy(dst, lines[line]->data + offset, chunk);
+        }
+
+        addr += chunk;
+        dst += chunk;
+        len -= chunk;
+    }
+
+    return total;
+}
+
+/* Repeated writes to one page coalesce into a single page write on eviction or flush */
+int bcache_write(uint16_t addr, const void *buf, uint16_t len) {
+    const uint8_t *src = buf;
+    const uint16_t total = len;
+
+    while (len > 0) {
+        const uint16_t offset = addr % BCACHE_LINE_SIZE;
+        uint16_t chunk = BCACHE_LINE_SIZE - offset;
+        int line;
+
+        if (chunk > len)
+            chunk = len;
+
+        if ((line = bcache_get(PAGE_OF(addr), chunk != BCACHE_LINE_SIZE)) < 0)
+            return -1;
+
+        memcpy(lines[line]->data + offset, src, chunk);
+        lines[line]->flags |= BCACHE_FLAG_DIRTY;
+
+        addr += chunk;
+        src += chunk;
+        len -= chunk;
+    }
+
+    return total;
+}
+
+/* Dirty lines go out in ascending page order, so the bus sees one forward sweep */
+int bcache_flush(void) {
+    for (;;) {
+        struct Bcache_Line *next = NULL;
+
+        for (uint8_t i = 0; i < count; i++)
+            if ((lines[i]->flags & BCACHE_FLAG_DIRTY) && (!next || (lines[i]->page < next->page)))
+                next = lines[i];
+
+        if (!next)
+            return 0;
+
+        if (bcache_writeback(next) < 0)
+            return -1;
+    }
+}
+
+/* Page pool reclaim hook: clean lines go back, so CHIP-8 can take them */
+void bcache_trim(void) {
+    uint8_t kept = 0;
+
+    bcache_flush();
+
+    for (uint8_t i = 0; i < count; i++) {
+        if (lines[i]->flags & BCACHE_FLAG_DIRTY)
+            lines[kept++] = lines[i];
+        else
+            pool_free(POOL_page, lines[i]);
+    }
+
+    count = kept;
+    for (uint8_t i = 0; i < count; i++)
+        lru[i] = i;
+}
@@ -0,0 +1,835 @@
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <avr/io.h>
+#include <avr/pgmspace.h>
+
+#include "chip8.h"
+#include "chip8_mem.h"
+#include "rexz.h"
+#include "sched.h"
+#include "video.h"
+#include "shell.h"
+#include "log.h"
+#include "fs.h"
+#include "ros.h"
+
+#define X(op)               (((op) >> 8) & 0xF)
+#define Y(op)               (((op) >> 4) & 0xF)
+#define N(op)               ((op) & 0xF)
+#define NN(op)              ((uint8_t)(op))
+#define NNN(op)             ((op) & 0xFFF)
+
+#define MS_TO_TICKS(ms)     (((ms) + SCHED_TICK_MS - 1) / SCHED_TICK_MS)
+#define TICKS_PER_SECOND    (1000 / SCHED_TICK_MS)
+
+/* Past this many ticks any timer value has run out */
+#define TIMER_SPAN_TICKS    (256UL * TICKS_PER_SECOND / CHIP8_TIMER_HZ)
+
+#define LOAD_CHUNK          32
+#define SYSCALL_ARGS        5           /* v1 ... v5 */
+
+/* LZSS window must stay in cache while the decoder reads it back */
+static_assert( REXZ_WINDOW + CHIP8_PAGE_SIZE <= CHIP8_CACHE_LINES * CHIP8_PAGE_SIZE );
+
+/* Below enum FS_Error, so both fit one result */
+enum Chip8_Error {
+    CHIP8_ERROR_IMAGE = -16,
+};
+
+typedef void (*Chip8_Op)(uint16_t);
+typedef void (*Chip8_Syscall)(void);
+
+struct PACKED Syscall_Group {
+    const Chip8_Syscall *calls;         /* PROGMEM */
+    uint8_t count;
+};
+
+static struct Chip8_Regs regs;
+static struct Chip8_Result result;
+static uint8_t args_count = 0;
+static char **args = NULL;
+static uint16_t random_state = 1;
+static uint16_t syscall_op;             /* CROS being served, for faults in syscalls */
+
+static void fault(uint16_t op) {
+    result.state = CHIP8_STATE_FAULT;
+    result.pc = regs.pc - 2;
+    result.opcode = op;
+}
+
+/* 60 Hz count from 100 Hz scheduler ticks since the timer was set */
+static uint8_t timer_value(uint8_t value, uint16_t set_tick) {
+    const uint16_t ticks = sched_now() - set_tick;
+    const uint16_t expired = (ticks >= TIMER_SPAN_TICKS) ? 0xFF : ticks * CHIP8_TIMER_HZ / TICKS_PER_SECOND;
+
+    return (expired >= value) ? 0 : (uint8_t)(value - expired);
+}
+
+static uint8_t random8(void) {
+    random_state ^= random_state << 7;
+    random_state ^= random_state >> 9;
+    random_state ^= random_state << 8;
+    return (uint8_t)random_state;
+}
+
+/* ----------------------------- CROS syscalls ----------------------------- */
+
+static bool copy_string(uint16_t addr, char *buf, uint8_t cap) {
+    for (uint8_t n = 0; n < cap; n++)
+        if ((buf[n] = (char)chip8_mem_read(addr + n)) == '\0')
+            return true;
+
+    return false;
+}
+
+/* Only conversions that take an int: values come from 8-bit registers. Trailing '%' is
+   rejected, strchr() would find its NUL and the caller would step past the end */
+static bool format_valid(const char *fmt) {
+    for (; *fmt; fmt++)
+        if ((*fmt == '%') && ((*++fmt == '\0') || !strchr("dxXc%", *fmt)))
+            return false;
+
+    return true;
+}
+
+static uint8_t read_line(char *buf, uint8_t cap) {
+    uint8_t len = 0;
+    int ch;
+
+    while (((ch = ros_wait_key()) != '\n') && (ch != '\r')) {
+        if ((ch == '\b') || (ch == 0x7F)) {
+            if (len) {
+                len --;
+                ros_putchar(ATTRIBUTE_DEFAULT, '\b');
+                ros_putchar(ATTRIBUTE_DEFAULT, ' ');
+                ros_putchar(ATTRIBUTE_DEFAULT, '\b');
+                ros_apply_output_entrys();
+            }
+            continue;
+        }
+
+        if ((ch < ' ') || (len + 1 >= cap))
+            continue;
+
+        buf[len ++] = (char)ch;
+        ros_putchar(ATTRIBUTE_DEFAULT, (unsigned char)ch);
+        ros_apply_output_entrys();
+    }
+
+    buf[len] = '\0';
+    ros_putchar(ATTRIBUTE_DEFAULT, '\n');
+    return len;
+}
+
+static void sys_puts(void) {
+    uint8_t n = 0;
+    unsigned char ch;
+
+    while ((n < UINT8_MAX) && ((ch = chip8_mem_read(regs.i + n)) != '\0')) {
+        ros_putchar(ATTRIBUTE_DEFAULT, ch);
+        n ++;
+    }
+
+    regs.v[0] = n;
+}
+
+static void sys_putc(void) {
+    regs.v[0] = ros_putchar(ATTRIBUTE_DEFAULT, regs.v[1]);
+}
+
+static void sys_putf(void) {
+    char fmt[CHIP8_FORMAT_CAP];
+
+    if (!copy_string(regs.i, fmt, sizeof(fmt)) || !format_valid(fmt)) {
+        fault(syscall_op);
+        return;
+    }
+
+    regs.v[0] = (uint8_t)ros_printf(ATTRIBUTE_DEFAULT, fmt, regs.v[1], regs.v[2], regs.v[3], regs.v[4], regs.v[5]);
+}
+
+static void sys_putb(void) {
+    for (uint8_t n = 0; n < regs.v[1]; n++)
+        ros_putchar(ATTRIBUTE_DEFAULT, chip8_mem_read(regs.i + n));
+
+    regs.v[0] = regs.v[1];
+}
+
+static void sys_put2(void) {
+    char str[CHIP8_LINE_CAP];
+
+    if (!copy_string(regs.i, str, sizeof(str))) {
+        fault(syscall_op);
+        return;
+    }
+
+    regs.v[0] = (uint8_t)ros_puts_2x(ATTRIBUTE_DEFAULT, USTR(str), false);
+}
+
+static void sys_gets(void) {
+    char line[CHIP8_LINE_CAP];
+    uint8_t len;
+
+    if (!regs.v[1]) {
+        regs.v[0] = 0;
+        return;
+    }
+
+    len = read_line(line, (regs.v[1] < sizeof(line)) ? regs.v[1] : sizeof(line));
+
+    for (uint8_t n = 0; n <= len; n++)
+        chip8_mem_write(regs.i + n, (uint8_t)line[n]);
+
+    regs.v[0] = len;
+}
+
+static void sys_getc(void) {
+    int ch;
+
+    while ((ch = ros_wait_key()) < 0)
+        ;
+
+    regs.v[0] = (uint8_t)ch;
+}
+
+/* Spaces in format match any run of spaces, %d and %x skip leading ones */
+static void sys_getf(void) {
+    char fmt[CHIP8_FORMAT_CAP], line[CHIP8_LINE_CAP];
+    const char *in = line;
+    uint8_t count = 0;
+
+    if (!copy_string(regs.i, fmt, sizeof(fmt)) || !format_valid(fmt)) {
+        fault(syscall_op);
+        return;
+    }
+
+    read_line(line, sizeof(line));
+
+    for (const char *f = fmt; *f && (count < SYSCALL_ARGS); f++) {
+        char *end;
+
+        if (*f == ' ') {
+            while (*in == ' ')
+                in ++;
+            continue;
+        }
+
+        if ((*f != '%') || (*++f == '%')) {
+            if (*in != *f)
+                break;
+            in ++;
+            continue;
+        }
+
+        if (*f == 'c') {
+            if (!*in)
+                break;
+            regs.v[1 + count ++] = (uint8_t)*in++;
+            continue;
+        }
+
+        while (*in == ' ')
+            in ++;
+
+        const unsigned long value = strtoul(in, &end, (*f == 'd') ? 10 : 16);
+        if (end == in)
+            break;
+
+        in = end;
+        regs.v[1 + count ++] = (uint8_t)value;
+    }
+
+    regs.v[0] = count;
+}
+
+/* Arguments after 'run', index 0 is the program file */
+static void sys_geta(void) {
+    const uint8_t idx = regs.v[1];
+    uint16_t n = 0;
+
+    if (idx >= args_count) {
+        regs.v[0] = 1;
+        return;
+    }
+
+    for (const char *p = args[idx]; *p && (n < CHIP8_LOAD_ADDR - CHIP8_ARG_ADDR - 1); p++)
+        chip8_mem_write(CHIP8_ARG_ADDR + n ++, (uint8_t)*p);
+
+    chip8_mem_write(CHIP8_ARG_ADDR + n, '\0');
+    regs.v[0] = 0;
+}
+
+static void sys_getb(void) {
+    uint16_t n = 0;
+
+    for (uint8_t a = 1; a < args_count; a++) {
+        if ((a > 1) && (n < CHIP8_LOAD_ADDR - CHIP8_ARG_ADDR - 1))
+            chip8_mem_write(CHIP8_ARG_ADDR + n ++, ' ');
+
+        for (const char *p = args[a]; *p && (n < CHIP8_LOAD_ADDR - CHIP8_ARG_ADDR - 1); p++)
+            chip8_mem_write(CHIP8_ARG_ADDR + n ++, (uint8_t)*p);
+    }
+
+    chip8_mem_write(CHIP8_ARG_ADDR + n, '\0');
+    regs.v[0] = 0;
+}
+
+static void sys_shcr(void) {
+    enable_cursor();
+    regs.v[0] = 0;
+}
+
+static void sys_hdcr(void) {
+    disable_cursor();
+    regs.v[0] = 0;
+}
+
+static void sys_stcr(void) {
+    if (regs.v[1])
+        enable_cursor();
+    else
+        disable_cursor();
+
+    regs.v[0] = 0;
+}
+
+static void sys_mvcr(void) {
+    ros_move_cursor(regs.v[1], regs.v[2]);
+    regs.v[0] = 0;
+}
+
+static void sys_atcr(void) {
+    graphic_cursor.attrib_high = regs.v[1];
+    graphic_cursor.attrib_low = regs.v[2];
+    regs.v[0] = 0;
+}
+
+static void sys_paus(void) {
+    ros_puts_P(ATTRIBUTE_DEFAULT, USTR(PSTR("Press any key to continue. . .")), false);
+    ros_wait_key();
+    ros_putchar(ATTRIBUTE_DEFAULT, '\n');
+}
+
+static void sys_slms(void) {
+    const uint16_t begin = sched_now();
+
+    ros_apply_output_entrys();
+    while ((uint16_t)(sched_now() - begin) < MS_TO_TICKS(regs.i))
+        ;
+}
+
+static void sys_exit(void) {
+    result.state = CHIP8_STATE_EXIT;
+    result.code = regs.v[1];
+}
+
+static void sys_abrt(void) {
+    result.state = CHIP8_STATE_ABORT;
+}
+
+/* Same numbering as enum Log_Type, critical is not reachable */
+static void sys_logg(void) {
+    char fmt[CHIP8_FORMAT_CAP];
+
+    if ((regs.v[1] > LOG_TYPE_WARNING) || !copy_string(regs.i, fmt, sizeof(fmt)) || !format_valid(fmt)) {
+        fault(syscall_op);
+        return;
+    }
+
+    ros_log((enum Log_Type)regs.v[1], fmt, regs.v[2], regs.v[3], regs.v[4], regs.v[5]);
+    regs.v[0] = 0;
+}
+
+static void sys_cplt(void) { regs.v[0] = regs.v[1] < regs.v[2]; }
+static void sys_cpgt(void) { regs.v[0] = regs.v[1] > regs.v[2]; }
+static void sys_cple(void) { regs.v[0] = regs.v[1] <= regs.v[2]; }
+static void sys_cpge(void) { regs.v[0] = regs.v[1] >= regs.v[2]; }
+static void sys_omul(void) { regs.v[0] = (uint8_t)(regs.v[1] * regs.v[2]); }
+
+static void sys_odiv(void) {
+    if (!regs.v[2])
+        fault(syscall_op);
+    else
+        regs.v[0] = regs.v[1] / regs.v[2];
+}
+
+static void sys_omod(void) {
+    if (!regs.v[2])
+        fault(syscall_op);
+    else
+        regs.v[0] = regs.v[1] % regs.v[2];
+}
+
+static void sys_sqrt(void) {
+    uint8_t root = 0;
+
+    while ((uint16_t)(root + 1) * (root + 1) <= regs.v[1])
+        root ++;
+
+    regs.v[0] = root;
+}
+
+/* Numbering of asm/rossys.rch8: group in high nibble of CROS argument, index in low byte */
+static const Chip8_Syscall calls_io[] PROGMEM = { sys_puts, sys_putc, sys_putf, sys_putb, sys_gets, sys_getc, sys_getf, sys_put2 };
+static const Chip8_Syscall calls_args[] PROGMEM = { sys_geta, sys_getb };
+static const Chip8_Syscall calls_cursor[] PROGMEM = { sys_shcr, sys_hdcr, sys_stcr, sys_mvcr, sys_atcr };
+static const Chip8_Syscall calls_flow[] PROGMEM = { sys_paus, sys_slms, sys_exit, sys_abrt };
+static const Chip8_Syscall calls_log[] PROGMEM = { sys_logg };
+static const Chip8_Syscall calls_math[] PROGMEM = { sys_cplt, sys_cpgt, sys_cple, sys_cpge, sys_omul, sys_odiv, sys_omod, sys_sqrt };
+
+#define GROUP(table)    { table, sizeof(table) / sizeof(table[0]) }
+
+/* Group 6 ( s_hder, red screen ) is system only and left empty */
+static const struct Syscall_Group syscall_groups[] PROGMEM = {
+    [0x1] = GROUP(calls_io),
+    [0x2] = GROUP(calls_args),
+    [0x3] = GROUP(calls_cursor),
+    [0x4] = GROUP(calls_flow),
+    [0x5] = GROUP(calls_log),
+    [0x7] = GROUP(calls_math),
+};
+
+#undef GROUP
+
+/* Screen is only updated by video task otherwise, which does not run under a program */
+static void syscall(uint16_t op) {
+    const uint8_t group = NNN(op) >> 8, index = NN(op);
+    struct Syscall_Group g = { 0 };
+
+    if (group < sizeof(syscall_groups) / sizeof(syscall_groups[0]))
+        memcpy_P(&g, &syscall_groups[group], sizeof(g));
+
+    if (index >= g.count) {
+        fault(op);
+        return;
+    }
+
+    syscall_op = op;
+    ((Chip8_Syscall)pgm_read_word(&g.calls[index]))();
+    ros_apply_output_entrys();
+}
+
+/* ----------------------------- Instructions ----------------------------- */
+
+/* 00E0 clear, 00EE return, any other 0NNN is CROS */
+static void op_sys(uint16_t op) {
+    if (op == 0x00E0) {
+        clear_screen(0x0000);
+        return;
+    }
+
+    if (op == 0x00EE) {
+        if (!regs.sp)
+            fault(op);
+        else
+            regs.pc = regs.stack[-- regs.sp];
+        return;
+    }
+
+    syscall(op);
+}
+
+static void op_jump(uint16_t op) {
+    regs.pc = NNN(op);
+}
+
+static void op_call(uint16_t op) {
+    if (regs.sp >= CHIP8_STACK_DEPTH) {
+        fault(op);
+        return;
+    }
+
+    regs.stack[regs.sp ++] = regs.pc;
+    regs.pc = NNN(op);
+}
+
+static void op_se_imm(uint16_t op) {
+    if (regs.v[X(op)] == NN(op))
+        regs.pc += 2;
+}
+
+static void op_sne_imm(uint16_t op) {
+    if (regs.v[X(op)] != NN(op))
+        regs.pc += 2;
+}
+
+static void op_se_reg(uint16_t op) {
+    if (N(op))
+        fault(op);
+    else if (regs.v[X(op)] == regs.v[Y(op)])
+        regs.pc += 2;
+}
+
+static void op_set_imm(uint16_t op) {
+    regs.v[X(op)] = NN(op);
+}
+
+static void op_add_imm(uint16_t op) {
+    regs.v[X(op)] += NN(op);
+}
+
+/* VF is written last, so it may be an operand. Shifts are of VX, assembler puts VF in Y */
+static void op_alu(uint16_t op) {
+    uint8_t *vx = &regs.v[X(op)];
+    const uint8_t vy = regs.v[Y(op)];
+    uint8_t flag;
+
+    switch (N(op)) {
+    case 0x0: *vx = vy;  return;
+    case 0x1: *vx |= vy; return;
+    case 0x2: *vx &= vy; return;
+    case 0x3: *vx ^= vy; return;
+    case 0x4: flag = ((uint16_t)*vx + vy) > 0xFF; *vx += vy; break;
+    case 0x5: flag = *vx >= vy; *vx -= vy; break;
+    case 0x6: flag = *vx & 1; *vx >>= 1; break;
+    case 0x7: flag = vy >= *vx; *vx = vy - *vx; break;
+    case 0xE: flag = *vx >> 7; *vx <<= 1; break;
+    default:
+        fault(op);
+        return;
+    }
+
+    regs.v[0xF] = flag;
+}
+
+static void op_sne_reg(uint16_t op) {
+    if (N(op))
+        fault(op);
+    else if (regs.v[X(op)] != regs.v[Y(op)])
+        regs.pc += 2;
+}
+
+static void op_set_i(uint16_t op) {
+    regs.i = NNN(op);
+}
+
+static void op_jump_v0(uint16_t op) {
+    regs.pc = (NNN(op) + regs.v[0]) & (CHIP8_MEM_SIZE - 1);
+}
+
+static void op_rnd(uint16_t op) {
+    regs.v[X(op)] = random8() & NN(op);
+}
+
+/* Text console has no sprite plane */
+static void op_draw(uint16_t op) {
+    fault(op);
+}
+
+/* No keypad state is kept, so no key is ever held */
+static void op_key(uint16_t op) {
+    if (NN(op) == 0xA1)
+        regs.pc += 2;
+    else if (NN(op) != 0x9E)
+        fault(op);
+}
+
+static void op_misc(uint16_t op) {
+    uint8_t *vx = &regs.v[X(op)];
+    int ch;
+
+    switch (NN(op)) {
+    case 0x07:
+        *vx = timer_value(regs.delay, regs.delay_tick);
+        break;
+
+    case 0x0A:
+        while ((ch = ros_wait_key()) < 0)
+            ;
+        *vx = (uint8_t)ch;
+        break;
+
+    case 0x15:
+        regs.delay = *vx;
+        regs.delay_tick = sched_now();
+        break;
+
+    /* No buzzer, sound timer is only kept */
+    case 0x18:
+        regs.sound = *vx;
+        regs.sound_tick = sched_now();
+        break;
+
+    case 0x1E:
+        regs.i = (regs.i + *vx) & (CHIP8_MEM_SIZE - 1);
+        break;
+
+    case 0x33:
+        chip8_mem_write(regs.i, *vx / 100);
+        chip8_mem_write(regs.i + 1, (*vx / 10) % 10);
+        chip8_mem_write(regs.i + 2, *vx % 10);
+        break;
+
+    /* I is left unchanged, as assembler's DUMP/LOAD expect */
+    case 0x55:
+        for (uint8_t r = 0; r <= X(op); r++)
+            chip8_mem_write(regs.i + r, regs.v[r]);
+        break;
+
+    case 0x65:
+        for (uint8_t r = 0; r <= X(op); r++)
+            regs.v[r] = chip8_mem_read(regs.i + r);
+        break;
+
+    default:
+        fault(op);
+        break;
+    }
+}
+
+/* Indexed by high nibble of opcode */
+static const Chip8_Op ops[16] PROGMEM = {
+    op_sys,     op_jump,    op_call,    op_se_imm,
+    op_sne_imm, op_se_reg,  op_set_imm, op_add_imm,
+    op_alu,     op_sne_reg, op_set_i,   op_jump_v0,
+    op_rnd,     op_draw,    op_key,     op_misc,
+};
+
+void chip8_reset(uint8_t argc, char **argv) {
+    memset(&regs, 0, sizeof(regs));
+    memset(&result, 0, sizeof(result));
+
+    regs.pc = CHIP8_LOAD_ADDR;
+    args_count = argc;
+    args = argv;
+
+    random_state = ((uint16_t)TCNT0 << 8) ^ sched_now();
+    if (!random_state)
+        random_state = 1;
+}
+
+/* Runs until program exits or faults, or for 'ticks' scheduler ticks if not 0 */
+struct Chip8_Result chip8_run(uint16_t ticks) {
+    const uint16_t begin = sched_now();
+    uint8_t batch = 0;
+
+    while (result.state == CHIP8_STATE_RUNNING) {
+        const uint16_t op = chip8_mem_fetch(regs.pc);
+
+        regs.pc = (regs.pc + 2) & (CHIP8_MEM_SIZE - 1);
+        ((Chip8_Op)pgm_read_word(&ops[op >> 12]))(op);
+        result.instructions ++;
+
+        /* Clock is looked at once per 256 instructions */
+        if (ticks && !++batch && ((uint16_t)(sched_now() - begin) >= ticks))
+            result.state = CHIP8_STATE_TIMEOUT;
+    }
+
+    ros_apply_output_entrys();
+    return result;
+}
+
+/* ----------------------------- Commands ----------------------------- */
+
+/* File bytes one at a time, next chunk is read when the previous one is used up */
+struct Load_Stream {
+    const struct FS_File *file;
+    uint16_t offset;
+    uint8_t pos, len;
+    uint8_t chunk[LOAD_CHUNK];
+};
+
+static int stream_getc(struct Load_Stream *s) {
+    if (s->pos == s->len) {
+        int len;
+
+        if (s->offset >= s->file->entry.size)
+            return CHIP8_ERROR_IMAGE;
+
+        if ((len = fs_read(s->file, s->offset, s->chunk, sizeof(s->chunk))) <= 0)
+            return FS_ERROR_IO;
+
+        s->offset += (uint16_t)len;
+        s->len = (uint8_t)len;
+        s->pos = 0;
+    }
+
+    return s->chunk[s->pos ++];
+}
+
+/* LZSS of 'asm -compress' straight into CHIP-8 memory. Window is the memory unpacked so far:
+   it spans at most 5 consecutive pages, all of them sit in distinct cache lines */
+static int chip8_unpack(struct Load_Stream *s, uint16_t size) {
+    const uint16_t end = CHIP8_LOAD_ADDR + size;
+    uint16_t addr = CHIP8_LOAD_ADDR;
+    uint8_t flags = 0, items = 0;
+    int c, d;
+
+    while (addr < end) {
+        if (!items) {
+            if ((c = stream_getc(s)) < 0)
+                return c;
+
+            flags = (uint8_t)c;
+            items = 8;
+        }
+
+        if ((c = stream_getc(s)) < 0)
+            return c;
+
+        if (flags & 1)
+            chip8_mem_write(addr ++, (uint8_t)c);
+        else {
+            if ((d = stream_getc(s)) < 0)
+                return d;
+
+            const uint16_t distance = (uint16_t)c + 1;
+            uint16_t len = (uint16_t)d + REXZ_MATCH_MIN;
+
+            if ((distance > addr - CHIP8_LOAD_ADDR) || (len > end - addr))
+                return CHIP8_ERROR_IMAGE;
+
+            /* Byte by byte, so a match may overlap its own output */
+            for (; len; len--, addr++)
+                chip8_mem_write(addr, chip8_mem_read(addr - distance));
+        }
+
+        flags >>= 1;
+        items --;
+    }
+
+    return FS_OK;
+}
+
+/* Raw .rex goes in by chunks, compressed one through the decoder, both as EEPROM pages arrive */
+static int chip8_load_file(const char *path) {
+    struct Load_Stream s = { .file = NULL };
+    struct Rexz_Header header;
+    struct FS_File file;
+    int err;
+
+    if ((err = fs_open(path, &file)) < 0)
+        return err;
+    s.file = &file;
+
+    if ((file.entry.size >= sizeof(header)) &&
+        ((err = fs_read(&file, 0, &header, sizeof(header))) == sizeof(header)) &&
+        !memcmp_P(header.magic, PSTR(REXZ_MAGIC), sizeof(header.magic))) {
+        if (header.size > CHIP8_MEM_SIZE - CHIP8_LOAD_ADDR)
+            return FS_ERROR_RANGE;
+
+        s.offset = sizeof(header);
+        return chip8_unpack(&s, header.size);
+    }
+
+    if (err < 0)
+        return err;
+
+    if (file.entry.size > CHIP8_MEM_SIZE - CHIP8_LOAD_ADDR)
+        return FS_ERROR_RANGE;
+
+    for (; s.offset < file.entry.size; s.offset += s.len) {
+        if ((err = fs_read(&file, s.offset, s.chunk, sizeof(s.chunk))) <= 0)
+            return FS_ERROR_IO;
+        s.len = (uint8_t)err;
+
+        if (chip8_mem_load(CHIP8_LOAD_ADDR + s.offset, s.chunk, s.len) < 0)
+            return FS_ERROR_IO;
+    }
+
+    return FS_OK;
+}
+
+static const char *chip8_strerror(int err) {
+    switch (err) {
+    case CHIP8_ERROR_IMAGE:  return "Bad image";
+    case FS_ERROR_NAME:      return "Bad name";
+    case FS_ERROR_NOT_FOUND: return "Not found";
+    case FS_ERROR_RANGE:     return "Too large";
+    case FS_ERROR_BAD_FS:    return "No filesystem";
+    case FS_ERROR_IO:        return "I/O error";
+    default:                 return "Error";
+    }
+}
+
+/* 'run prog.rex [args]', exit code of the program is the command result */
+int shell_cmd_run(uint8_t argc, char **argv) {
+    struct Chip8_Result r;
+    int err;
+
+    if (chip8_mem_init() < 0) {
+        ros_log(LOG_TYPE_ERROR, "No memory");
+        return -1;
+    }
+
+    if ((err = chip8_load_file(argv[1])) < 0) {
+        chip8_mem_release();
+        ros_log(LOG_TYPE_ERROR, "%s", chip8_strerror(err));
+        return err;
+    }
+
+    chip8_reset(argc - 1, argv + 1);
+    r = chip8_run(0);
+    chip8_mem_release();
+
+    switch (r.state) {
+    case CHIP8_STATE_FAULT:
+        ros_log(LOG_TYPE_ERROR, "Fault %x at %x", r.opcode, r.pc);
+        return -1;
+
+    case CHIP8_STATE_ABORT:
+        ros_log(LOG_TYPE_ERROR, "Aborted");
+        return -1;
+
+    default:
+        return r.code;
+    }
+}
+
+/* ALU, memory through page cache, skips, calls and jumps in one loop:
+        v0 = 0, I = 300h
+   loop v0 += 1, v1 += v0, dump v0..v1, load v0..v1
+        if v0 == 0 call sub
+        goto loop
+   sub  v2 += 1, ret */
+static const uint16_t bench_program[] PROGMEM = {
+    0x6000, 0xA300,
+    0x7001, 0x8104, 0xF155, 0xF165,
+    0x4000, 0x2212,
+    0x1204,
+    0x7201, 0x00EE,
+};
+
+int shell_cmd_c8bench(uint8_t argc, char **argv) {
+    uint8_t image[sizeof(bench_program)];
+    struct Chip8_Result r;
+    uint16_t begin, ticks;
+    uint32_t ips;
+
+    (void) argc;
+
+    if (chip8_mem_init() < 0) {
+        ros_log(LOG_TYPE_ERROR, "No memory");
+        return -1;
+    }
+
+    /* Big-endian, as assembler writes it */
+    for (uint8_t n = 0; n < sizeof(bench_program) / 2; n++) {
+        const uint16_t op = pgm_read_word(&bench_program[n]);
+
+        image[2 * n] = HI8(op);
+        image[2 * n + 1] = LO8(op);
+    }
+    chip8_mem_load(CHIP8_LOAD_ADDR, image, sizeof(image));
+
+    chip8_reset(1, argv);
+    begin = sched_now();
+    r = chip8_run(CHIP8_BENCH_TICKS);
+    ticks = sched_now() - begin;
+    chip8_mem_release();
+
+    if (r.state != CHIP8_STATE_TIMEOUT) {
+        ros_log(LOG_TYPE_ERROR, "Fault %x at %x", r.opcode, r.pc);
+        return -1;
+    }
+
+    ips = r.instructions * TICKS_PER_SECOND / ticks;
+
+    /* ros_printf has 16-bit %d only */
+    ros_printf(ATTRIBUTE_DEFAULT, "%d.%dk instr/s\n", (int)(ips / 1000), (int)(ips % 1000 / 100));
+    ros_printf(ATTRIBUTE_DEFAULT, "%d cycles/instr\n", (int)(F_CPU / ips));
+    return 0;
+}
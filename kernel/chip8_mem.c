@@ -0,0 +1,219 @@
+#include <inttypes.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "chip8_mem.h"
+#include "xram.h"
+#include "pool.h"
+#include "video.h"
+#include "shell.h"
+#include "prof.h"
+#include "ros.h"
+
+#define PAGE_OF(addr)       ((uint8_t)(((addr) & (CHIP8_MEM_SIZE - 1)) >> CHIP8_PAGE_SHIFT))
+#define OFFSET_OF(addr)     ((uint8_t)((addr) & (CHIP8_PAGE_SIZE - 1)))
+#define LINE_OF(page)       ((page) & (CHIP8_CACHE_LINES - 1))
+
+/* With PROFILE each access is timed on TIMER1, otherwise CHIP8_CYCLES_* are summed */
+#ifdef PROFILE
+    #define COST(n)             do { } while( 0 )
+    #define ACCESS_BEGIN()      const uint32_t _access = prof_now()
+    #define ACCESS_END()        stats.cycles += prof_now() - _access
+#else
+    #define COST(n)             stats.cycles += (n)
+    #define ACCESS_BEGIN()      do { } while( 0 )
+    #define ACCESS_END()        do { } while( 0 )
+#endif
+
+/* Lines are held only while a program is loaded */
+static_assert( sizeof(struct Chip8_Line) <= POOL_BLOCK_SIZE(page) );
+
+static struct Chip8_Line *lines[CHIP8_CACHE_LINES] = { 0 };
+static Xram_Handle backing = XRAM_NULL;
+static uint8_t pinned = CHIP8_NO_PAGE;
+static struct Chip8_Mem_Stats stats = { 0 };
+
+static void line_writeback(struct Chip8_Line *line) {
+    if (!(line->flags & CHIP8_LINE_DIRTY))
+        return;
+
+    xram_write(backing, (uint16_t)line->page << CHIP8_PAGE_SHIFT, line->data, CHIP8_PAGE_SIZE);
+    line->flags &= (uint8_t)~CHIP8_LINE_DIRTY;
+    stats.writebacks ++;
+    COST(CHIP8_CYCLES_PAGE);
+}
+
+static void invalidate(void) {
+    for (uint8_t i = 0; i < CHIP8_CACHE_LINES; i++) {
+        lines[i]->page = CHIP8_NO_PAGE;
+        lines[i]->flags = 0;
+    }
+
+    pinned = CHIP8_NO_PAGE;
+}
+
+static void lines_free(void) {
+    for (uint8_t i = 0; i < CHIP8_CACHE_LINES; i++) {
+        pool_free(POOL_page, lines[i]);
+        lines[i] = NULL;
+    }
+}
+
+/* Whole set or nothing, block cache is asked to shrink when pool runs dry */
+static int lines_alloc(void) {
+    for (uint8_t i = 0; i < CHIP8_CACHE_LINES; i++) {
+        if (lines[i])
+            continue;
+
+        if (!(lines[i] = pool_alloc(POOL_page))) {
+            pool_reclaim(POOL_page);
+
+            if (!(lines[i] = pool_alloc(POOL_page))) {
+                lines_free();
+                return -1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/* Backs the whole address space with external SRAM, zero-filled */
+int chip8_mem_init(void) {
+    if ((backing == XRAM_NULL) && ((backing = xram_alloc(CHIP8_MEM_SIZE)) == XRAM_NULL))
+        return -1;
+
+    if (lines_alloc() < 0) {
+        chip8_mem_release();
+        return -1;
+    }
+
+    invalidate();
+    memset(&stats, 0, sizeof(stats));
+
+    memset(lines[0]->data, 0, CHIP8_PAGE_SIZE);
+    for (uint8_t page = 0; page < CHIP8_PAGES_NUMBER; page++)
+        xram_write(backing, (uint16_t)page << CHIP8_PAGE_SHIFT, lines[0]->data, CHIP8_PAGE_SIZE);
+
+    return 0;
+}
+
+void chip8_mem_release(void) {
+    xram_free(backing);
+    backing = XRAM_NULL;
+    lines_free();
+    pinned = CHIP8_NO_PAGE;
+}
+
+void chip8_mem_flush(void) {
+    for (uint8_t i = 0; i < CHIP8_CACHE_LINES; i++)
+        if (lines[i])
+            line_writeback(lines[i]);
+}
+
+/* Line holding the page, or NULL when it would have to evict pinned code page */
+static struct Chip8_Line *line_get(uint8_t page, bool pin) {
+    struct Chip8_Line *line = lines[LINE_OF(page)];
+
+    if (line->page == page) {
+        stats.hits ++;
+        COST(CHIP8_CYCLES_HIT);
+        return line;
+    }
+
+    if (!pin && (line->page == pinned) && (pinned != CHIP8_NO_PAGE)) {
+        stats.bypass ++;
+        COST(CHIP8_CYCLES_BYTE);
+        return NULL;
+    }
+
+    stats.misses ++;
+    COST(CHIP8_CYCLES_PAGE);
+
+    line_writeback(line);
+    xram_read(backing, (uint16_t)page << CHIP8_PAGE_SHIFT, line->data, CHIP8_PAGE_SIZE);
+    line->page = page;
+    line->flags = 0;
+    return line;
+}
+
+/* Instruction fetch pins its page, so data accesses can't thrash the running code */
+uint16_t chip8_mem_fetch(uint16_t pc) {
+    const uint8_t page = PAGE_OF(pc);
+    struct Chip8_Line *line;
+
+    /* Opcodes are 2-byte aligned in practice, odd PC may straddle two pages */
+    if (OFFSET_OF(pc) == CHIP8_PAGE_SIZE - 1)
+        return ((uint16_t)chip8_mem_read(pc) << 8) | chip8_mem_read(pc + 1);
+
+    ACCESS_BEGIN();
+    line = line_get(page, true);
+    pinned = page;
+    const uint16_t opcode = ((uint16_t)line->data[OFFSET_OF(pc)] << 8) | line->data[OFFSET_OF(pc) + 1];
+    ACCESS_END();
+
+    return opcode;
+}
+
+uint8_t chip8_mem_read(uint16_t addr) {
+    ACCESS_BEGIN();
+    struct Chip8_Line *line = line_get(PAGE_OF(addr), false);
+    uint8_t value;
+
+    if (line)
+        value = line->data[OFFSET_OF(addr)];
+    else
+        xram_read(backing, addr & (CHIP8_MEM_SIZE - 1), &value, 1);
+
+    ACCESS_END();
+    return value;
+}
+
+void chip8_mem_write(uint16_t addr, uint8_t value) {
+    ACCESS_BEGIN();
+    struct Chip8_Line *line = line_get(PAGE_OF(addr), false);
+
+    if (line) {
+        line->data[OFFSET_OF(addr)] = value;
+        line->flags |= CHIP8_LINE_DIRTY;
+    } else
+        xram_write(backing, addr & (CHIP8_MEM_SIZE - 1), &value, 1);
+
+    ACCESS_END();
+}
+
+/* Bulk copy for loaders, goes around the cache */
+int chip8_mem_load(uint16_t addr, const void *buf, uint16_t len) {
+    if ((backing == XRAM_NULL) || ((uint32_t)addr + len > CHIP8_MEM_SIZE))
+        return -1;
+
+    chip8_mem_flush();
+    invalidate();
+    return xram_write(backing, addr, buf, len);
+}
+
+const struct Chip8_Mem_Stats *chip8_mem_stats(void) {
+    return &stats;
+}
+
+int shell_cmd_c8mem(uint8_t argc, char **argv) {
+    const uint32_t accesses = stats.hits + stats.misses + stats.bypass;
+
+    (void) argc;
+    (void) argv;
+
+    if (!accesses) {
+        ros_puts(ATTRIBUTE_DEFAULT, USTR("No accesses"), true);
+        return 0;
+    }
+
+    ros_printf(ATTRIBUTE_DEFAULT, "Hit rate\t%d%%\n", (int)(stats.hits * 100 / accesses));
+    ros_printf(ATTRIBUTE_DEFAULT, "Bypass\t%d%%\n", (int)(stats.bypass * 100 / accesses));
+    ros_printf(ATTRIBUTE_DEFAULT, "Writeback\t%d\n", stats.writebacks);
+#ifdef PROFILE
+    ros_printf(ATTRIBUTE_DEFAULT, "Cycles/acc\t%d\n", (int)(stats.cycles / accesses));
+#else
+    ros_printf(ATTRIBUTE_DEFAULT, "Est. cyc/acc\t%d\n", (int)(stats.cycles / accesses));
+#endif
+    return 0;
+}
@@ -0,0 +1,277 @@
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <avr/io.h>
+#include <avr/eeprom.h>
+#include <avr/pgmspace.h>
+#include <util/crc16.h>
+
+#include "config.h"
+#include "keyboard.h"
+#include "video.h"
+#include "sched.h"
+#include "shell.h"
+#include "log.h"
+#include "ros.h"
+
+#define BANK_BASE(b)        ((uint16_t)(EEPROM_CONFIG_BASE + (b) * CONFIG_BANK_SIZE))
+#define BANK_LOG(b)         ((uint16_t)(BANK_BASE(b) + sizeof(struct Config_Bank_Header)))
+#define BANK_END(b)         ((uint16_t)(BANK_BASE(b) + CONFIG_BANK_SIZE))
+#define RECORD_SIZE(len)    ((uint16_t)(sizeof(struct Config_Record_Header) + (len) + 1))
+
+#define EE_READ(addr)       eeprom_read_byte((const uint8_t *)(uintptr_t)(addr))
+#define EE_WRITE(addr, v)   eeprom_update_byte((uint8_t *)(uintptr_t)(addr), (v))
+
+#define CONFIG(name, def, help) #name,
+static const char names[CONFIG_KEYS_NUMBER][CONFIG_NAME_CAP] PROGMEM = {
+    #include "config.def"
+};
+#undef CONFIG
+
+#define CONFIG(name, def, help) def,
+static const uint8_t defaults[CONFIG_KEYS_NUMBER] PROGMEM = {
+    #include "config.def"
+};
+#undef CONFIG
+
+/* EEPROM address of newest record per key, 0 = not stored */
+static uint16_t record_index[CONFIG_KEYS_NUMBER] = { 0 };
+static uint8_t bank = 0, sequence = 0;
+static uint16_t log_end = 0;
+static uint16_t scan_us = 0;
+
+/* TIMER0 ticks since boot, modulo 2^16: good for short intervals */
+static uint16_t timer_stamp(void) {
+    uint16_t ticks;
+    uint8_t count;
+
+    do {
+        ticks = sched_now();
+        count = TCNT0;
+    } while (ticks != sched_now());
+
+    return (uint16_t)(ticks * ((uint16_t)OCR0A + 1) + count);
+}
+
+static uint8_t record_crc(uint16_t addr, uint8_t len) {
+    uint8_t crc = 0;
+
+    for (uint16_t i = 0; i < sizeof(struct Config_Record_Header) + len; i++)
+        crc = _crc8_ccitt_update(crc, EE_READ(addr + i));
+
+    return crc;
+}
+
+static bool bank_valid(uint8_t b, uint8_t *seq) {
+    struct Config_Bank_Header header;
+
+    eeprom_read_block(&header, (const void *)(uintptr_t)BANK_BASE(b), sizeof(header));
+    *seq = header.sequence;
+    return header.magic == CONFIG_MAGIC;
+}
+
+static void bank_commit(uint8_t b, uint8_t seq) {
+    const struct Config_Bank_Header header = { .magic = CONFIG_MAGIC, .sequence = seq };
+
+    /* Sequence first: torn header leaves the old magic, which is harmless */
+    EE_WRITE(BANK_BASE(b) + offsetof(struct Config_Bank_Header, sequence), header.sequence);
+    eeprom_update_word((uint16_t *)(uintptr_t)BANK_BASE(b), header.magic);
+
+    bank = b;
+    sequence = seq;
+}
+
+/* Walks log once, stops at end marker or first record, which fails CRC ( torn write ) */
+static void bank_scan(void) {
+    uint16_t pos = BANK_LOG(bank);
+
+    memset(record_index, 0, sizeof(record_index));
+
+    while (pos + RECORD_SIZE(0) <= BANK_END(bank)) {
+        const uint8_t key = EE_READ(pos);
+        const uint8_t len = EE_READ(pos + 1);
+
+        if ((key == CONFIG_END) || (len > CONFIG_VALUE_CAP) || (pos + RECORD_SIZE(len) > BANK_END(bank)))
+            break;
+
+        if (EE_READ(pos + RECORD_SIZE(len) - 1) != record_crc(pos, len))
+            break;
+
+        if (key < CONFIG_KEYS_NUMBER)
+            record_index[key] = pos;
+
+        pos += RECORD_SIZE(len);
+    }
+
+    log_end = pos;
+}
+
+/* Live records move to the other bank, its header is written last */
+static int bank_compact(void) {
+    const uint8_t to = bank ^ 1;
+    uint16_t pos = BANK_LOG(to);
+
+    for (uint8_t key = 0; key < CONFIG_KEYS_NUMBER; key++) {
+        uint16_t from = record_index[key];
+
+        if (!from)
+            continue;
+
+        const uint16_t size = RECORD_SIZE(EE_READ(from + 1));
+
+        for (uint16_t i = 0; i < size; i++)
+            EE_WRITE(pos + i, EE_READ(from + i));
+
+        record_index[key] = pos;
+        pos += size;
+    }
+
+    if (pos < BANK_END(to))
+        EE_WRITE(pos, CONFIG_END);
+
+    bank_commit(to, sequence + 1);
+    log_end = pos;
+    return 0;
+}
+
+void config_init(void) {
+    const uint16_t begin = timer_stamp();
+    uint8_t seq[CONFIG_BANKS];
+    bool valid[CONFIG_BANKS];
+
+    for (uint8_t b = 0; b < CONFIG_BANKS; b++)
+        valid[b] = bank_valid(b, &seq[b]);
+
+    if (valid[0] || valid[1]) {
+        bank = (valid[0] && valid[1]) ? ((int8_t)(seq[1] - seq[0]) > 0) : valid[1];
+        sequence = seq[bank];
+    } else {
+        EE_WRITE(BANK_LOG(0), CONFIG_END);
+        bank_commit(0, 0);
+    }
+
+    bank_scan();
+
+    scan_us = (uint16_t)(timer_stamp() - begin) * 64;
+    config_apply();
+}
+
+void config_apply(void) {
+    graphic_cursor.attrib_low = config_get_byte(CONFIG_KEY_cur_low);
+    graphic_cursor.attrib_high = config_get_byte(CONFIG_KEY_cur_high);
+    keyboard_set_delay(config_get_byte(CONFIG_KEY_kbd_delay));
+    log_set_level(config_get_byte(CONFIG_KEY_log_level));
+}
+
+/* O(1): one index lookup, one block read */
+int config_get(enum Config_Key key, void *buf, uint8_t size) {
+    uint8_t len;
+
+    if ((key >= CONFIG_KEYS_NUMBER) || !record_index[key])
+        return -1;
+
+    len = EE_READ(record_index[key] + 1);
+    if (len > size)
+        len = size;
+
+    eeprom_read_block(buf, (const void *)(uintptr_t)(record_index[key] + sizeof(struct Config_Record_Header)), len);
+    return len;
+}
+
+uint8_t config_get_byte(enum Config_Key key) {
+    uint8_t value;
+
+    if (config_get(key, &value, 1) < 1)
+        return pgm_read_byte(&defaults[key]);
+
+    return value;
+}
+
+/* Appends record, so each update lands on fresh cells */
+int config_set(enum Config_Key key, const void *data, uint8_t len) {
+    const uint8_t *src = data;
+    uint8_t crc = 0;
+
+    if ((key >= CONFIG_KEYS_NUMBER) || (len > CONFIG_VALUE_CAP))
+        return -1;
+
+    if (record_index[key] && (EE_READ(record_index[key] + 1) == len)) {
+        uint8_t i = 0;
+
+        while ((i < len) && (EE_READ(record_index[key] + sizeof(struct Config_Record_Header) + i) == src[i]))
+            i++;
+
+        if (i == len)
+            return 0;
+    }
+
+    if ((log_end + RECORD_SIZE(len) > BANK_END(bank)) && ((bank_compact() < 0) || (log_end + RECORD_SIZE(len) > BANK_END(bank))))
+        return -1;
+
+    crc = _crc8_ccitt_update(crc, key);
+    crc = _crc8_ccitt_update(crc, len);
+
+    EE_WRITE(log_end + 1, len);
+    for (uint8_t i = 0; i < len; i++) {
+        EE_WRITE(log_end + sizeof(struct Config_Record_Header) + i, src[i]);
+        crc = _crc8_ccitt_update(crc, src[i]);
+    }
+    EE_WRITE(log_end + RECORD_SIZE(len) - 1, crc);
+
+    if (log_end + RECORD_SIZE(len) < BANK_END(bank))
+        EE_WRITE(log_end + RECORD_SIZE(len), CONFIG_END);
+
+    /* Record becomes visible only now */
+    EE_WRITE(log_end, key);
+
+    record_index[key] = log_end;
+    log_end += RECORD_SIZE(len);
+    return 0;
+}
+
+int config_find(const char *name) {
+    for (uint8_t key = 0; key < CONFIG_KEYS_NUMBER; key++)
+        if (!strncmp_P(name, names[key], CONFIG_NAME_CAP))
+            return key;
+
+    return -1;
+}
+
+int shell_cmd_cfg(uint8_t argc, char **argv) {
+    int key;
+
+    if (argc == 1) {
+        char name[CONFIG_NAME_CAP];
+
+        for (key = 0; key < CONFIG_KEYS_NUMBER; key++) {
+            strncpy_P(name, names[key], CONFIG_NAME_CAP);
+            ros_printf(ATTRIBUTE_DEFAULT, "%s\t%x\n", name, config_get_byte(key));
+        }
+
+        ros_printf(ATTRIBUTE_DEFAULT, "Free\t%d\n", BANK_END(bank) - log_end);
+        ros_printf(ATTRIBUTE_DEFAULT, "Scan\t%d us\n", scan_us);
+        return 0;
+    }
+
+    if ((key = config_find(argv[1])) < 0) {
+        ros_log(LOG_TYPE_ERROR, "Bad key: %s", argv[1]);
+        return -1;
+    }
+
+    if (argc == 2) {
+        ros_printf(ATTRIBUTE_DEFAULT, "%x\n", config_get_byte(key));
+        return 0;
+    }
+
+    const uint8_t value = (uint8_t)strtoul(argv[2], NULL, 0);
+
+    if (config_set(key, &value, 1) < 0) {
+        ros_log(LOG_TYPE_ERROR, "Config full");
+        return -1;
+    }
+
+    config_apply();
+    return 0;
+}
@@ -0,0 +1,131 @@
+#include <inttypes.h>
+#include <stdbool.h>
+
+#include <avr/io.h>
+#include <util/atomic.h>
+
+#include "defer.h"
+#include "sched.h"
+#include "video.h"
+#include "shell.h"
+#include "ros.h"
+
+static struct Work queue[DEFER_QUEUE_CAP] = { 0 };
+static volatile uint8_t queue_head = 0, queue_tail = 0;
+
+volatile uint16_t irq_worst[IRQ_PROBES_NUMBER] = { 0 };
+volatile uint8_t defer_dropped = 0;
+
+/* Ticks don't move while interrupts are off, so a wrap of TIMER0 during the window is only
+   seen as its pending compare flag. Flag is read on both sides of TCNT0 to pair them up */
+struct Irq_Stamp irq_stamp(uint8_t ahead) {
+    struct Irq_Stamp stamp;
+    uint8_t cnt;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        const bool before = TIFR0 & BIT(OCF0A);
+        cnt = TCNT0;
+        stamp.pending = TIFR0 & BIT(OCF0A);
+        if (stamp.pending && !before)
+            cnt = TCNT0;
+
+        stamp.counts = (sched_now() + stamp.pending + ahead) * ((uint16_t)OCR0A + 1) + cnt;
+    }
+
+    return stamp;
+}
+
+void irq_account(enum Irq_Probe probe, struct Irq_Stamp begin) {
+    const struct Irq_Stamp end = irq_stamp(0);
+    uint16_t elapsed = end.counts - begin.counts;
+
+    /* Flag holds one match only. A window that loses more than that can read as running
+       backwards, it is kept as saturated instead of a small, wrong value */
+    if ((elapsed >= IRQ_WORST_SATURATED) || ((int16_t)elapsed < 0))
+        elapsed = IRQ_WORST_SATURATED;
+
+    if (elapsed > irq_worst[probe])
+        irq_worst[probe] = elapsed;
+}
+
+/* ISR-safe: captures routine & argument, real work runs in task context */
+bool defer(Work_Routine routine, uint8_t arg) {
+    bool queued = false;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        const uint8_t next = (queue_head + 1) & (DEFER_QUEUE_CAP - 1);
+
+        if (next == queue_tail) {
+            defer_dropped ++;
+        } else {
+            queue[queue_head] = (struct Work){ .routine = routine, .arg = arg };
+            queue_head = next;
+            queued = true;
+        }
+    }
+
+    if (queued)
+        sched_signal(SCHED_EVENT_WORK);
+    return queued;
+}
+
+static bool defer_pop(struct Work *work) {
+    bool popped = false;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        if (queue_tail != queue_head) {
+            *work = queue[queue_tail];
+            queue_tail = (queue_tail + 1) & (DEFER_QUEUE_CAP - 1);
+            popped = true;
+        }
+    }
+
+    return popped;
+}
+
+static void __callback defer_task(struct Task *self) {
+    static struct Work work;
+
+    TASK_BEGIN(self);
+
+    for (;;) {
+        /* Items queued while draining are picked up in the same pass */
+        while (defer_pop(&work))
+            (work.routine)(work.arg);
+
+        TASK_WAIT_EVENT(self, SCHED_EVENT_WORK);
+    }
+
+    TASK_END(self);
+}
+
+void defer_init(void) { sched_spawn(defer_task); }
+
+int shell_cmd_irq(uint8_t argc, char **argv) {
+    static const char *const names[IRQ_PROBES_NUMBER] = {
+        [IRQ_PROBE_INT0]   = "INT0",
+        [IRQ_PROBE_TIMER0] = "TIMER0",
+        [IRQ_PROBE_FLUSH]  = "FLUSH",
+    };
+
+    (void) argc;
+    (void) argv;
+
+    for (uint8_t i = 0; i < IRQ_PROBES_NUMBER; i++) {
+        uint16_t worst;
+
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+            worst = irq_worst[i];
+
+        /* Counts are 64 us, past 32 ms only milliseconds fit in %d */
+        if (worst == IRQ_WORST_SATURATED)
+            ros_printf(ATTRIBUTE_DEFAULT, "%s\t>%d ms\n", names[i], 2 * SCHED_TICK_MS);
+        else if (worst < 500)
+            ros_printf(ATTRIBUTE_DEFAULT, "%s\t<%d us\n", names[i], (worst + 1) * 64);
+        else
+            ros_printf(ATTRIBUTE_DEFAULT, "%s\t<%d ms\n", names[i], (int)((worst + 1) * 64UL / 1000 + 1));
+    }
+
+    ros_printf(ATTRIBUTE_DEFAULT, "Dropped\t%d\n", defer_dropped);
+    return 0;
+}
@@ -0,0 +1,316 @@
+#include <stddef.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <string.h>
+#include <ctype.h>
+
+#include "fs.h"
+
+#define PAGE_ADDR(p)        ((uint16_t)((p) * FS_PAGE_SIZE))
+#define SLOT_ADDR(s)        ((uint16_t)(PAGE_ADDR(FS_DIR_PAGE) + (s) * sizeof(struct FS_Entry)))
+#define PAGES_FOR(bytes)    ((uint16_t)(((bytes) + FS_PAGE_SIZE - 1) / FS_PAGE_SIZE))
+
+static const struct FS_Device *device = NULL;
+static struct FS_Superblock super = { 0 };
+
+/* Extensions from README file format list */
+static const char extensions[][FS_EXT_CAP] = { "rex", "raw", "txt", "rtm", "rch8", "rnx" };
+
+/* "name.ext" -> padded 8.4 entry name, lowercase */
+static int fs_parse_name(const char *path, struct FS_Entry *entry) {
+    const char *dot = strchr(path, '.');
+    size_t len = dot ? (size_t)(dot - path) : 0;
+
+    if (!dot || !len || (len > FS_NAME_CAP) || (strlen(dot + 1) > FS_EXT_CAP))
+        return FS_ERROR_NAME;
+
+    memset(entry->name, 0, FS_NAME_CAP + FS_EXT_CAP);
+
+    for (size_t i = 0; i < len; i++) {
+        if (!isalnum((unsigned char)path[i]) && (path[i] != '_') && (path[i] != '-'))
+            return FS_ERROR_NAME;
+        entry->name[i] = (char)tolower((unsigned char)path[i]);
+    }
+
+    for (size_t i = 0; dot[i + 1]; i++)
+        entry->ext[i] = (char)tolower((unsigned char)dot[i + 1]);
+
+    for (size_t i = 0; i < sizeof(extensions) / sizeof(extensions[0]); i++)
+        if (!strncmp(entry->ext, extensions[i], FS_EXT_CAP))
+            return FS_OK;
+
+    return FS_ERROR_NAME;
+}
+
+static uint8_t fs_hash(const struct FS_Entry *entry) {
+    const uint8_t *p = (const uint8_t *)entry->name;
+    uint16_t h = 0x811C;
+
+    for (uint8_t i = 0; i < FS_NAME_CAP + FS_EXT_CAP; i++)
+        h = (h ^ p[i]) * 0x0193u;
+
+    return (uint8_t)((h ^ (h >> 8)) % FS_DIR_SLOTS);
+}
+
+static inline bool fs_same_name(const struct FS_Entry *a, const struct FS_Entry *b) {
+    return !memcmp(a->name, b->name, FS_NAME_CAP + FS_EXT_CAP);
+}
+
+static int fs_read_slot(uint8_t slot, struct FS_Entry *entry) {
+    return device->read(SLOT_ADDR(slot), entry, sizeof(*entry));
+}
+
+static int fs_write_slot(uint8_t slot, const struct FS_Entry *entry) {
+    return device->write(SLOT_ADDR(slot), entry, sizeof(*entry));
+}
+
+static int fs_write_super(void) {
+    return device->write(PAGE_ADDR(FS_SUPER_PAGE), &super, sizeof(super));
+}
+
+/* Linear probing, stops at never-used slot: O(1) while directory is sparse */
+static int fs_probe(const struct FS_Entry *key, struct FS_Entry *found, int *free_slot) {
+    struct FS_Entry cur;
+    uint8_t slot = fs_hash(key);
+
+    if (free_slot)
+        *free_slot = -1;
+
+    for (uint8_t n = 0; n < FS_DIR_SLOTS; n++, slot = (slot + 1) % FS_DIR_SLOTS) {
+        if (fs_read_slot(slot, &cur) < 0)
+            return FS_ERROR_IO;
+
+        if ((uint8_t)cur.name[0] == FS_SLOT_FREE) {
+            if (free_slot && (*free_slot < 0))
+                *free_slot = slot;
+            return FS_ERROR_NOT_FOUND;
+        }
+
+        if ((uint8_t)cur.name[0] == FS_SLOT_DELETED) {
+            if (free_slot && (*free_slot < 0))
+                *free_slot = slot;
+            continue;
+        }
+
+        if (fs_same_name(&cur, key)) {
+            if (found)
+                *found = cur;
+            return slot;
+        }
+    }
+
+    return FS_ERROR_NOT_FOUND;
+}
+
+/* First fit over page bitmap */
+static int fs_alloc(uint16_t pages, uint16_t *start) {
+    uint8_t bitmap[FS_PAGE_SIZE];
+    uint16_t run = 0;
+
+    if (!pages) {
+        *start = 0;
+        return FS_OK;
+    }
+
+    if (device->read(PAGE_ADDR(FS_BITMAP_PAGE), bitmap, sizeof(bitmap)) < 0)
+        return FS_ERROR_IO;
+
+    for (uint16_t p = FS_DATA_PAGE; p < super.pages; p++) {
+        run = (bitmap[p >> 3] & (1 << (p & 7))) ? 0 : run + 1;
+
+        if (run < pages)
+            continue;
+
+        *start = p + 1 - pages;
+        for (uint16_t q = *start; q <= p; q++)
+            bitmap[q >> 3] |= (uint8_t)(1 << (q & 7));
+
+        super.free_pages -= pages;
+        if ((device->write(PAGE_ADDR(FS_BITMAP_PAGE), bitmap, sizeof(bitmap)) < 0) || (fs_write_super() < 0))
+            return FS_ERROR_IO;
+        return FS_OK;
+    }
+
+    return FS_ERROR_NO_SPACE;
+}
+
+static int fs_release(uint16_t start, uint16_t pages) {
+    uint8_t bitmap[FS_PAGE_SIZE];
+
+    if (!pages)
+        return FS_OK;
+
+    if (device->read(PAGE_ADDR(FS_BITMAP_PAGE), bitmap, sizeof(bitmap)) < 0)
+        return FS_ERROR_IO;
+
+    for (uint16_t q = start; q < start + pages; q++)
+        bitmap[q >> 3] &= (uint8_t)~(1 << (q & 7));
+
+    super.free_pages += pages;
+    if ((device->write(PAGE_ADDR(FS_BITMAP_PAGE), bitmap, sizeof(bitmap)) < 0) || (fs_write_super() < 0))
+        return FS_ERROR_IO;
+    return FS_OK;
+}
+
+int fs_format(const struct FS_Device *dev) {
+    uint8_t page[FS_PAGE_SIZE];
+    const uint16_t pages = (dev->pages > FS_PAGES_CAP) ? FS_PAGES_CAP : dev->pages;
+
+    if (pages <= FS_DATA_PAGE)
+        return FS_ERROR_NO_SPACE;
+
+    device = dev;
+
+    /* Empty directory */
+    memset(page, 0, sizeof(page));
+    for (uint16_t p = FS_DIR_PAGE; p < FS_DATA_PAGE; p++)
+        if (device->write(PAGE_ADDR(p), page, sizeof(page)) < 0)
+            return FS_ERROR_IO;
+
+    /* Metadata pages and pages past the end of device are never allocated */
+    for (uint16_t p = 0; p < FS_PAGES_CAP; p++)
+        if ((p < FS_DATA_PAGE) || (p >= pages))
+            page[p >> 3] |= (uint8_t)(1 << (p & 7));
+
+    if (device->write(PAGE_ADDR(FS_BITMAP_PAGE), page, sizeof(page)) < 0)
+        return FS_ERROR_IO;
+
+    super = (struct FS_Superblock){
+        .magic = FS_MAGIC,
+        .version = FS_VERSION,
+        .page_size = FS_PAGE_SIZE,
+        .pages = pages,
+        .free_pages = pages - FS_DATA_PAGE,
+        .dir_slots = FS_DIR_SLOTS
+    };
+
+    return (fs_write_super() < 0) ? FS_ERROR_IO : FS_OK;
+}
+
+int fs_mount(const struct FS_Device *dev) {
+    device = dev;
+
+    if (device->read(PAGE_ADDR(FS_SUPER_PAGE), &super, sizeof(super)) < 0)
+        return FS_ERROR_IO;
+
+    if ((super.magic != FS_MAGIC) || (super.version != FS_VERSION) || (super.page_size != FS_PAGE_SIZE) ||
+        (super.dir_slots != FS_DIR_SLOTS) || (super.pages > dev->pages)) {
+        device = NULL;
+        return FS_ERROR_BAD_FS;
+    }
+
+    return FS_OK;
+}
+
+const struct FS_Superblock *fs_superblock(void) { return device ? &super : NULL; }
+
+int fs_open(const char *path, struct FS_File *file) {
+    struct FS_Entry key;
+    int res;
+
+    if (!device)
+        return FS_ERROR_BAD_FS;
+
+    if ((res = fs_parse_name(path, &key)) < 0)
+        return res;
+
+    if ((res = fs_probe(&key, &file->entry, NULL)) < 0)
+        return res;
+
+    file->slot = (uint8_t)res;
+    return FS_OK;
+}
+
+int fs_create(const char *path, uint16_t size, struct FS_File *file) {
+    struct FS_Entry entry;
+    uint16_t start;
+    int res, slot;
+
+    if (!device)
+        return FS_ERROR_BAD_FS;
+
+    if ((res = fs_parse_name(path, &entry)) < 0)
+        return res;
+
+    if ((res = fs_probe(&entry, NULL, &slot)) >= 0)
+        return FS_ERROR_EXISTS;
+
+    if (res != FS_ERROR_NOT_FOUND)
+        return res;
+
+    if (slot < 0)
+        return FS_ERROR_DIR_FULL;
+
+    if ((res = fs_alloc(PAGES_FOR(size), &start)) < 0)
+        return res;
+
+    entry.start = start;
+    entry.size = size;
+    if (fs_write_slot((uint8_t)slot, &entry) < 0)
+        return FS_ERROR_IO;
+
+    if (file) {
+        file->entry = entry;
+        file->slot = (uint8_t)slot;
+    }
+    return FS_OK;
+}
+
+int fs_remove(const char *path) {
+    struct FS_File file;
+    int res;
+
+    if ((res = fs_open(path, &file)) < 0)
+        return res;
+
+    if ((res = fs_release(file.entry.start, PAGES_FOR(file.entry.size))) < 0)
+        return res;
+
+    /* Tombstone keeps probe chains of other names intact */
+    file.entry.name[0] = (char)FS_SLOT_DELETED;
+    return (fs_write_slot(file.slot, &file.entry) < 0) ? FS_ERROR_IO : FS_OK;
+}
+
+/* Iterates over used slots, *iter must start at 0 */
+int fs_readdir(uint8_t *iter, struct FS_Entry *entry) {
+    if (!device)
+        return FS_ERROR_BAD_FS;
+
+    while (*iter < FS_DIR_SLOTS) {
+        if (fs_read_slot((*iter)++, entry) < 0)
+            return FS_ERROR_IO;
+
+        if (((uint8_t)entry->name[0] != FS_SLOT_FREE) && ((uint8_t)entry->name[0] != FS_SLOT_DELETED))
+            return FS_OK;
+    }
+
+    return FS_ERROR_NOT_FOUND;
+}
+
+static uint16_t fs_clamp(const struct FS_File *file, uint16_t offset, uint16_t len) {
+    if (offset >= file->entry.size)
+        return 0;
+
+    return ((uint32_t)offset + len > file->entry.size) ? (uint16_t)(file->entry.size - offset) : len;
+}
+
+uint16_t fs_address(const struct FS_File *file, uint16_t offset) {
+    return PAGE_ADDR(file->entry.start) + offset;
+}
+
+/* Extent is contiguous, so any range is a single device transfer */
+int fs_read(const struct FS_File *file, uint16_t offset, void *buf, uint16_t len) {
+    len = fs_clamp(file, offset, len);
+
+    if (len && (device->read(fs_address(file, offset), buf, len) < 0))
+        return FS_ERROR_IO;
+    return len;
+}
+
+int fs_write(const struct FS_File *file, uint16_t offset, const void *buf, uint16_t len) {
+    len = fs_clamp(file, offset, len);
+
+    if (len && (device->write(fs_address(file, offset), buf, len) < 0))
+        return FS_ERROR_IO;
+    return len;
+}
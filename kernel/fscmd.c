@@ -0,0 +1,129 @@
+#include <inttypes.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "eeprom24.h"
+#include "bcache.h"
+#include "video.h"
+#include "shell.h"
+#include "log.h"
+#include "fs.h"
+#include "ros.h"
+
+#define CAT_CHUNK       32
+
+static const char *fs_strerror(int err) {
+    switch (err) {
+    case FS_ERROR_IO:        return "I/O error";
+    case FS_ERROR_NAME:      return "Bad name";
+    case FS_ERROR_EXISTS:    return "File exists";
+    case FS_ERROR_NOT_FOUND: return "Not found";
+    case FS_ERROR_DIR_FULL:  return "Dir full";
+    case FS_ERROR_NO_SPACE:  return "No space";
+    case FS_ERROR_BAD_FS:    return "No filesystem";
+    default:                 return "Error";
+    }
+}
+
+static int fs_report(int err) {
+    if (err < 0)
+        ros_log(LOG_TYPE_ERROR, "%s", fs_strerror(err));
+
+    return err;
+}
+
+/* Runs before the screen is up, so the caller reports the result */
+bool fs_bootup(void) {
+    bcache_init(&eeprom24_device);
+    return fs_mount(&bcache_device) >= 0;
+}
+
+int shell_cmd_ls(uint8_t argc, char **argv) {
+    char name[FS_NAME_CAP + FS_EXT_CAP + 2];
+    struct FS_Entry entry;
+    uint8_t iter = 0;
+    int err;
+
+    (void) argc;
+    (void) argv;
+
+    /* Entry names are padded, not terminated */
+    while ((err = fs_readdir(&iter, &entry)) == FS_OK) {
+        const uint8_t len = (uint8_t)strnlen(entry.name, FS_NAME_CAP);
+
+        memcpy(name, entry.name, len);
+        name[len] = '.';
+        memcpy(name + len + 1, entry.ext, FS_EXT_CAP);
+        name[len + 1 + FS_EXT_CAP] = '\0';
+
+        ros_printf(ATTRIBUTE_DEFAULT, "%s\t%d\n", name, entry.size);
+    }
+
+    if (err != FS_ERROR_NOT_FOUND)
+        return fs_report(err);
+
+    ros_printf(ATTRIBUTE_DEFAULT, "%d pages free\n", fs_superblock()->free_pages);
+    return 0;
+}
+
+int shell_cmd_cat(uint8_t argc, char **argv) {
+    uint8_t chunk[CAT_CHUNK];
+    struct FS_File file;
+    uint16_t offset = 0;
+    int len, err;
+
+    (void) argc;
+
+    if ((err = fs_open(argv[1], &file)) < 0)
+        return fs_report(err);
+
+    /* Each chunk is a single sequential read on the bus */
+    while ((len = fs_read(&file, offset, chunk, CAT_CHUNK)) > 0) {
+        for (int i = 0; i < len; i++)
+            ros_putchar(ATTRIBUTE_DEFAULT, chunk[i]);
+
+        offset += (uint16_t)len;
+    }
+
+    return fs_report(len);
+}
+
+int shell_cmd_rm(uint8_t argc, char **argv) {
+    int err;
+
+    (void) argc;
+
+    if ((err = fs_remove(argv[1])) == FS_OK)
+        err = bcache_flush();
+
+    return fs_report(err);
+}
+
+int shell_cmd_mkfs(uint8_t argc, char **argv) {
+    int err;
+
+    (void) argc;
+    (void) argv;
+
+    if ((err = fs_format(&bcache_device)) == FS_OK)
+        err = bcache_flush();
+
+    return fs_report(err);
+}
+
+int shell_cmd_cache(uint8_t argc, char **argv) {
+    const struct Bcache_Stats *st = bcache_stats();
+
+    (void) argc;
+    (void) argv;
+
+    if (bcache_flush() < 0)
+        return fs_report(FS_ERROR_IO);
+
+    ros_printf(ATTRIBUTE_DEFAULT, "Hits\t%d\n", st->hits);
+    ros_printf(ATTRIBUTE_DEFAULT, "Misses\t%d\n", st->misses);
+    ros_printf(ATTRIBUTE_DEFAULT, "Ahead\t%d\n", st->readahead);
+    ros_printf(ATTRIBUTE_DEFAULT, "Bypass\t%d\n", st->bypass);
+    ros_printf(ATTRIBUTE_DEFAULT, "Writes\t%d\n", st->writebacks);
+    return 0;
+}
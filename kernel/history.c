@@ -0,0 +1,190 @@
+#include <inttypes.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <avr/io.h>
+#include <avr/eeprom.h>
+#include <util/atomic.h>
+
+#include "history.h"
+#include "sched.h"
+#include "ros.h"
+
+#define RING_WRAP(i)            ((uint8_t)((i) % HISTORY_RING_CAP))
+#define RING_OFFSET(field)      ((uint8_t)offsetof(struct History_Ring, field))
+
+#define EEPROM_MAGIC_ADDR       ((uint16_t *)(EEPROM_HISTORY_BASE))
+#define EEPROM_RING_ADDR        ((uint8_t *)(EEPROM_HISTORY_BASE + sizeof(uint16_t)))
+
+static struct History_Ring ring = { 0 };
+
+/* One bit per ring byte, that differs from EEPROM mirror */
+static uint8_t dirty[(sizeof(struct History_Ring) + 7) / 8] = { 0 };
+static uint8_t sync_pos = 0;
+
+static inline void ring_touch(uint8_t offset) {
+    dirty[offset >> 3] |= BIT(offset & 7);
+}
+
+static inline void ring_set(uint8_t pos, uint8_t val) {
+    if (ring.raw[pos] == val)
+        return;
+
+    ring.raw[pos] = val;
+    ring_touch(RING_OFFSET(raw) + pos);
+}
+
+static void ring_set_header(uint8_t tail, uint8_t used, uint8_t count) {
+    ring.tail = tail;
+    ring.used = used;
+    ring.count = count;
+
+    ring_touch(RING_OFFSET(tail));
+    ring_touch(RING_OFFSET(used));
+    ring_touch(RING_OFFSET(count));
+}
+
+static inline uint8_t entry_next(uint8_t pos) {
+    return RING_WRAP(pos + 1 + ring.raw[pos]);
+}
+
+static bool entry_equals(uint8_t pos, const char *line, uint8_t len) {
+    if (ring.raw[pos] != len)
+        return false;
+
+    for (uint8_t i = 0; i < len; i++)
+        if (ring.raw[RING_WRAP(pos + 1 + i)] != (uint8_t)line[i])
+            return false;
+
+    return true;
+}
+
+static void entry_remove(uint8_t pos) {
+    const uint8_t size = 1 + ring.raw[pos];
+    const uint8_t rel = RING_WRAP(pos - ring.tail + HISTORY_RING_CAP);
+
+    /* Close the hole by shifting younger entries back */
+    for (uint8_t k = rel; k < ring.used - size; k++)
+        ring_set(RING_WRAP(ring.tail + k), ring.raw[RING_WRAP(ring.tail + k + size)]);
+
+    ring_set_header(ring.tail, ring.used - size, ring.count - 1);
+}
+
+static void __callback history_task(struct Task *);
+
+static bool history_load(void) {
+    if (eeprom_read_word(EEPROM_MAGIC_ADDR) != HISTORY_MAGIC)
+        return false;
+
+    eeprom_read_block(&ring, EEPROM_RING_ADDR, sizeof(ring));
+    if ((ring.tail >= HISTORY_RING_CAP) || (ring.used > HISTORY_RING_CAP))
+        return false;
+
+    /* Header bytes are mirrored before the data, a reset mid-sync leaves them out of step */
+    uint16_t total = 0;
+    uint8_t pos = ring.tail;
+
+    for (uint8_t i = 0; i < ring.count; i++, pos = entry_next(pos)) {
+        if (!ring.raw[pos] || (ring.raw[pos] > HISTORY_ENTRY_CAP))
+            return false;
+
+        if ((total += 1 + ring.raw[pos]) > ring.used)
+            return false;
+    }
+
+    return total == ring.used;
+}
+
+void history_init(void) {
+    if (!history_load()) {
+        /* No valid mirror: start empty and let history_sync() rewrite it */
+        memset(&ring, 0, sizeof(ring));
+        memset(dirty, 0xFF, sizeof(dirty));
+        eeprom_update_word(EEPROM_MAGIC_ADDR, HISTORY_MAGIC);
+    }
+
+    sched_spawn(history_task);
+}
+
+uint8_t history_size(void) { return ring.count; }
+
+void history_push(const char *line, uint8_t len) {
+    if (!len || (len > HISTORY_ENTRY_CAP))
+        return;
+
+    /* Deduplicate: identical command is moved to the newest position */
+    uint8_t pos = ring.tail;
+    for (uint8_t i = 0; i < ring.count; i++, pos = entry_next(pos))
+        if (entry_equals(pos, line, len)) {
+            entry_remove(pos);
+            break;
+        }
+
+    /* Evict oldest entries until the new one fits */
+    while (ring.used + len + 1 > HISTORY_RING_CAP)
+        ring_set_header(entry_next(ring.tail), ring.used - 1 - ring.raw[ring.tail], ring.count - 1);
+
+    pos = RING_WRAP(ring.tail + ring.used);
+    ring_set(pos, len);
+    for (uint8_t i = 0; i < len; i++)
+        ring_set(RING_WRAP(pos + 1 + i), (uint8_t)line[i]);
+
+    ring_set_header(ring.tail, ring.used + len + 1, ring.count + 1);
+}
+
+/* Copies entry ( 0 - newest ) to dest, and reports first byte that has changed */
+int history_recall(uint8_t age, char *dest, uint8_t dest_size, uint8_t *first_diff) {
+    if (age >= ring.count)
+        return -1;
+
+    uint8_t pos = ring.tail;
+    for (uint8_t i = ring.count - 1; i > age; i--)
+        pos = entry_next(pos);
+
+    uint8_t len = ring.raw[pos];
+    if (len > dest_size)
+        len = dest_size;
+
+    *first_diff = len;
+    for (uint8_t i = 0; i < len; i++) {
+        const char ch = (char)ring.raw[RING_WRAP(pos + 1 + i)];
+
+        if ((dest[i] != ch) && (*first_diff == len))
+            *first_diff = i;
+        dest[i] = ch;
+    }
+
+    return len;
+}
+
+/* Writes at most one dirty byte per call, never waits for EEPROM */
+void history_sync(void) {
+    if (!eeprom_is_ready())
+        return;
+
+    for (uint8_t n = 0; n < sizeof(struct History_Ring); n++, sync_pos = (sync_pos + 1) % sizeof(struct History_Ring)) {
+        uint8_t val;
+
+        if (!(dirty[sync_pos >> 3] & BIT(sync_pos & 7)))
+            continue;
+
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+            dirty[sync_pos >> 3] &= ~BIT(sync_pos & 7);
+            val = ((const uint8_t *)&ring)[sync_pos];
+        }
+
+        eeprom_update_byte(EEPROM_RING_ADDR + sync_pos, val);
+        return;
+    }
+}
+
+static void __callback history_task(struct Task *self) {
+    TASK_BEGIN(self);
+
+    for (;;) {
+        history_sync();
+        TASK_WAIT_EVENT(self, SCHED_EVENT_TICK);
+    }
+
+    TASK_END(self);
+}
@@ -0,0 +1,222 @@
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#include <avr/io.h>
+#include <avr/boot.h>
+#include <avr/pgmspace.h>
+#include <util/atomic.h>
+#include <util/twi.h>
+
+#include "app.h"
+#include "eeprom24.h"
+#include "bcache.h"
+#include "video.h"
+#include "shell.h"
+#include "log.h"
+#include "fs.h"
+#include "ros.h"
+
+#define VERIFY_CHUNK        32
+
+static_assert( APP_BASE % SPM_PAGESIZE == 0 );
+static_assert( APP_BOOT_BASE % SPM_PAGESIZE == 0 );
+
+/* Below enum FS_Error, so both fit one result */
+enum Loader_Error {
+    LOADER_ERROR_IMAGE = -16,
+    LOADER_ERROR_ABI = -17,
+    LOADER_ERROR_SIZE = -18,
+    LOADER_ERROR_IO = -19,
+    LOADER_ERROR_VERIFY = -20,
+};
+
+/* Kernel image end, native program must not be linked over it */
+extern const char __data_load_end[];
+
+/* Boot section code runs with interrupts off: while a page is erased or written
+   the RWW section ( kernel, vectors ) cannot be read, so nothing here calls out of it */
+#define BOOT_INLINE         static inline __attribute__((always_inline))
+
+BOOT_INLINE uint8_t boot_twi(uint8_t twcr) {
+    TWCR = twcr | BIT(TWINT) | BIT(TWEN);
+    while (!(TWCR & BIT(TWINT)))
+        ;
+
+    return TW_STATUS;
+}
+
+BOOT_INLINE void boot_twi_stop(void) {
+    TWCR = BIT(TWINT) | BIT(TWEN) | BIT(TWSTO);
+    while (TWCR & BIT(TWSTO))
+        ;
+}
+
+BOOT_INLINE bool boot_twi_send(uint8_t byte, uint8_t expected) {
+    TWDR = byte;
+    return boot_twi(0) == expected;
+}
+
+/* Sets EEPROM address and turns bus around: bytes then come sequentially, ACK polls write cycle */
+BOOT_INLINE bool boot_eeprom_open(uint16_t addr) {
+    for (uint16_t tries = 0; tries < TWI_POLL_LIMIT; tries++) {
+        if ((boot_twi(BIT(TWSTA)) == TW_START) &&
+            boot_twi_send(EEPROM24_ADDRESS << 1 | TW_WRITE, TW_MT_SLA_ACK) &&
+            boot_twi_send((uint8_t)(addr >> 8), TW_MT_DATA_ACK) &&
+            boot_twi_send((uint8_t)addr, TW_MT_DATA_ACK) &&
+            (boot_twi(BIT(TWSTA)) == TW_REP_START) &&
+            boot_twi_send(EEPROM24_ADDRESS << 1 | TW_READ, TW_MR_SLA_ACK))
+            return true;
+
+        boot_twi_stop();
+    }
+
+    return false;
+}
+
+/* Last byte is NACKed */
+BOOT_INLINE uint8_t boot_eeprom_next(bool last) {
+    boot_twi(last ? 0 : BIT(TWEA));
+    return TWDR;
+}
+
+/* Next SPM page from open sequential read, tail past the image is erased-flash 0xFF */
+BOOT_INLINE void boot_eeprom_page(uint8_t *page, uint16_t *left) {
+    for (uint16_t i = 0; i < SPM_PAGESIZE; i++) {
+        if (*left) {
+            -- *left;
+            page[i] = boot_eeprom_next(*left == 0);
+        } else
+            page[i] = 0xFF;
+    }
+}
+
+/* Copies EEPROM image into flash. One SRAM page: once it is moved into SPM buffer,
+   next page is read into it while the previous one is being written ( ~2.9 ms of bus
+   time hides under ~4 ms write ). Unchanged pages are neither erased nor written.
+   Returns programmed pages or -1 */
+static int NOINLINE BOOTLOADER_SECTION flash_program(uint16_t dst, uint16_t src, uint16_t size) {
+    uint8_t page[SPM_PAGESIZE];
+    uint16_t left = size;
+    int programmed = 0;
+
+    if (!boot_eeprom_open(src))
+        return -1;
+
+    boot_eeprom_page(page, &left);
+
+    for (uint16_t addr = dst; addr < dst + size; addr += SPM_PAGESIZE) {
+        bool same = true;
+
+        for (uint16_t i = 0; i < SPM_PAGESIZE; i++)
+            same &= (pgm_read_byte(addr + i) == page[i]);
+
+        if (!same) {
+            boot_page_erase(addr);
+            boot_spm_busy_wait();
+
+            for (uint16_t i = 0; i < SPM_PAGESIZE; i += 2)
+                boot_page_fill(addr + i, page[i] | (uint16_t)page[i + 1] << 8);
+
+            boot_page_write(addr);
+            programmed ++;
+        }
+
+        boot_eeprom_page(page, &left);
+
+        boot_spm_busy_wait();
+        boot_rww_enable();
+    }
+
+    boot_twi_stop();
+    return programmed;
+}
+
+static int loader_verify(const struct FS_File *file) {
+    uint8_t chunk[VERIFY_CHUNK];
+    int len;
+
+    for (uint16_t offset = 0; offset < file->entry.size; offset += (uint16_t)len) {
+        if ((len = fs_read(file, offset, chunk, sizeof(chunk))) <= 0)
+            return LOADER_ERROR_IO;
+
+        for (uint8_t i = 0; i < (uint8_t)len; i++)
+            if (pgm_read_byte(APP_BASE + offset + i) != chunk[i])
+                return LOADER_ERROR_VERIFY;
+    }
+
+    return 0;
+}
+
+/* Image goes into flash only where it differs, so running the same program again costs a read */
+static int loader_install(const struct FS_File *file) {
+    struct App_Header header;
+    int programmed = -1, err;
+
+    if ((uint16_t)__data_load_end > APP_BASE)
+        return LOADER_ERROR_SIZE;
+
+    if ((file->entry.size < sizeof(header)) || (file->entry.size > APP_SIZE_CAP))
+        return LOADER_ERROR_SIZE;
+
+    if ((err = fs_read(file, 0, &header, sizeof(header))) < 0)
+        return err;
+
+    if (header.magic != APP_MAGIC)
+        return LOADER_ERROR_IMAGE;
+
+    if (header.abi_entries > APP_ABI_NUMBER)
+        return LOADER_ERROR_ABI;
+
+    /* Boot section reads EEPROM past the cache, bus must be idle */
+    if (bcache_flush() < 0)
+        return LOADER_ERROR_IO;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        programmed = flash_program(APP_BASE, fs_address(file, 0), file->entry.size);
+    }
+
+    if (programmed < 0)
+        return LOADER_ERROR_IO;
+
+    if ((err = loader_verify(file)) < 0)
+        return err;
+
+    if (programmed)
+        ros_printf(ATTRIBUTE_DEFAULT, "%d pages flashed\n", programmed);
+
+    return 0;
+}
+
+static const char *loader_strerror(int err) {
+    switch (err) {
+    case LOADER_ERROR_IMAGE:  return "Not a program";
+    case LOADER_ERROR_ABI:    return "Newer ABI";
+    case LOADER_ERROR_SIZE:   return "Too large";
+    case LOADER_ERROR_IO:     return "I/O error";
+    case LOADER_ERROR_VERIFY: return "Verify failed";
+    case FS_ERROR_NAME:       return "Bad name";
+    case FS_ERROR_NOT_FOUND:  return "Not found";
+    case FS_ERROR_BAD_FS:     return "No filesystem";
+    default:                  return "Error";
+    }
+}
+
+/* Native program from .rnx file: 'exec prog.rnx [args]', its argv[0] is the file name */
+int shell_cmd_exec(uint8_t argc, char **argv) {
+    struct FS_File file;
+    Shell_Handler entry;
+    int err;
+
+    if ((err = fs_open(argv[1], &file)) == FS_OK)
+        err = loader_install(&file);
+
+    if (err < 0) {
+        ros_log(LOG_TYPE_ERROR, "%s", loader_strerror(err));
+        return err;
+    }
+
+    entry = (Shell_Handler)pgm_read_word(APP_BASE + offsetof(struct App_Header, entry));
+    return entry(argc - 1, argv + 1);
+}
@@ -1,14 +1,15 @@
 #include <stdarg.h>
+#include <stdio.h>
 
 #include <avr/interrupt.h>
 #include <avr/pgmspace.h>
 
+#include "config.h"
 #include "video.h"
+#include "font.h"
+#include "sched.h"
 #include "log.h"
 
-#define ATTRIB_INFO    (struct Attribute){ 1, 1, 1,  0,  0, 0, 1,  1 }
-#define ATTRIB_WARN    (struct Attribute){ 1, 1, 0,  0,  0, 0, 0,  1 }
-#define ATTRIB_FAIL    (struct Attribute){ 1, 1, 1,  0,  1, 0, 0,  1 }
 
 static const unsigned char panic_message[] PROGMEM = 
     ":_(\n\n"
@@ -26,9 +27,16 @@ static void flash_puts(const char *data, uint8_t attrib, bool flag) {
     ros_puts(attrib, USTR(data), false);
 }
 
-static void __callback flash_info_callback(bool flash) { flash_puts("INFO", struct_attribute_to_raw(ATTRIB_INFO), flash); }
-static void __callback flash_warn_callback(bool flash) { flash_puts("WARN", struct_attribute_to_raw(ATTRIB_WARN), flash); }
-static void __callback flash_fail_callback(bool flash) { flash_puts("FAIL", struct_attribute_to_raw(ATTRIB_FAIL), flash); }
+static void __callback flash_info_callback(bool flash) { flash_puts("INFO", config_get_byte(CONFIG_KEY_log_info), flash); }
+static void __callback flash_warn_callback(bool flash) { flash_puts("WARN", config_get_byte(CONFIG_KEY_log_warn), flash); }
+static void __callback flash_fail_callback(bool flash) { flash_puts("FAIL", config_get_byte(CONFIG_KEY_log_fail), flash); }
+
+/* Console mirror gets tags as text */
+static const char tags[LOG_TYPES_NUMBER - 1][5] = {
+    [LOG_TYPE_INFO] = "INFO",
+    [LOG_TYPE_WARNING] = "WARN",
+    [LOG_TYPE_ERROR] = "FAIL",
+};
 
 static Flash_Routine flash_callbacks[LOG_TYPES_NUMBER - 1] = {
     [LOG_TYPE_INFO] = flash_info_callback,
@@ -36,12 +44,44 @@ static Flash_Routine flash_callbacks[LOG_TYPES_NUMBER - 1] = {
     [LOG_TYPE_ERROR] = flash_fail_callback,
 };
 
+/* Log types are not numbered by importance */
+static const uint8_t levels[LOG_TYPES_NUMBER - 1] = {
+    [LOG_TYPE_INFO] = 0,
+    [LOG_TYPE_WARNING] = 1,
+    [LOG_TYPE_ERROR] = 2,
+};
+
+/* Token bucket per type: LOG_BURST messages at once, then one per LOG_REFILL_TICKS */
+static struct PACKED Log_Bucket {
+    uint8_t tokens;
+    uint16_t tick;          /* Last refill */
+    uint8_t dropped;        /* Over the limit, not reported yet */
+} buckets[LOG_TYPES_NUMBER - 1] = {
+    [0 ... LOG_TYPES_NUMBER - 2] = { LOG_BURST, 0, 0 }
+};
+
+/* Only a hash of the last message is kept, repeats are counted instead of shown */
+static struct PACKED Log_Last {
+    uint16_t hash;
+    uint8_t type;
+    uint8_t repeats;
+} last = { .type = LOG_TYPE_CRITICAL };  /* Matches no shown message */
+
+static uint8_t level = 0;
+
+/* Not on the stack: ros_log is called from deep chains. Task context only, like ros_vprintf */
+static char line[LOG_LINE_CAP];
+
 static void __attribute__((noreturn)) enter_panic_mode(const int code) {
     sys_mode = SYSTEM_MODE_BUSY;
 
     disable_cursor();
     clear_screen(0xf800);
-    ros_printf(0x17, "**** STOP CODE: <%X>\n", code);
+
+    /* Fits one double size row */
+    char stop[SCREEN_WIDTH / LETTER_WIDTH / 2 + 1];
+    snprintf(stop, sizeof(stop), "STOP %X", code);
+    ros_puts_2x(0x17, USTR(stop), true);
     ros_puts_P(0x17, panic_message, false);
     ros_puts_P(0x1F, panic_link, false);
 
@@ -51,23 +91,140 @@ static void __attribute__((noreturn)) enter_panic_mode(const int code) {
         .visible = true
     };
 
+    /* TIMER0 only ticks, nothing else drains the queue anymore */
+    ros_apply_output_entrys();
+
     sei();
     for(;;);
 }
 
+void log_set_level(uint8_t lowest) {
+    level = lowest;
+}
+
+static bool bucket_take(struct Log_Bucket *b) {
+    const uint16_t now = sched_now();
+    const uint16_t refills = (uint16_t)(now - b->tick) / LOG_REFILL_TICKS;
+
+    if (refills) {
+        b->tokens = (b->tokens + refills > LOG_BURST) ? LOG_BURST : b->tokens + refills;
+        b->tick += refills * LOG_REFILL_TICKS;
+    }
+
+    if (!b->tokens)
+        return false;
+
+    b->tokens --;
+    return true;
+}
+
+static uint16_t message_hash(enum Log_Type type, const char *text) {
+    uint16_t hash = 0x811C ^ type;
+
+    while (*text)
+        hash = (hash ^ UCHR(*text++)) * 0x0193;
+
+    return hash;
+}
+
+static void log_head(enum Log_Type type) {
+    ros_flash(flash_callbacks[type]);
+    ros_mirror_puts(tags[type]);
+    ros_puts(ATTRIBUTE_DEFAULT, USTR("     "), false); /* 5 spaces ( log header + space ) */
+}
+
+/* Bypasses level, coalescing and rate limit, for prompts that must always show */
+void log_show(enum Log_Type type, const char *text) {
+    log_head(type);
+    ros_puts(ATTRIBUTE_DEFAULT, USTR(text), true);
+}
+
+/* Counts of hidden messages. Before the next shown message they go out unconditionally,
+   from log_task each needs a token of its type, so a storm that ends in silence is still reported */
+static void log_summary(bool limited) {
+    if (last.repeats && (!limited || bucket_take(&buckets[last.type]))) {
+        if (levels[last.type] >= level) {
+            log_head(last.type);
+            ros_printf(ATTRIBUTE_DEFAULT, "Repeated %d times\n", last.repeats);
+        }
+        last.repeats = 0;
+    }
+
+    for (uint8_t type = 0; type < LOG_TYPES_NUMBER - 1; type++) {
+        struct Log_Bucket *b = &buckets[type];
+
+        if (!b->dropped || (limited && !bucket_take(b)))
+            continue;
+
+        if (levels[type] >= level) {
+            log_head(type);
+            ros_printf(ATTRIBUTE_DEFAULT, "%d dropped\n", b->dropped);
+        }
+        b->dropped = 0;
+    }
+}
+
+/* Only while a command runs: in other modes the prompt and input line are on the last row */
+static void __callback log_task(struct Task *self) {
+    TASK_BEGIN(self);
+
+    for (;;) {
+        TASK_SLEEP(self, LOG_REFILL_TICKS);
+        if (sys_mode == SYSTEM_MODE_BUSY)
+            log_summary(true);
+    }
+
+    TASK_END(self);
+}
+
+/* Before a prompt: held counts go out, and a message that repeats one shown before
+   the prompt is shown again, as it comes from a new command */
+void log_prompt(void) {
+    log_summary(false);
+    last.hash = 0;
+    last.type = LOG_TYPE_CRITICAL;
+}
+
+void log_init(void) {
+    sched_spawn(log_task);
+}
+
 void ros_log(enum Log_Type type, const char *format, ...) {
     va_list vptr;
-    va_start(vptr, format);
 
     if (type == LOG_TYPE_CRITICAL) {
+        va_start(vptr, format);
         cli();
         int code = va_arg(vptr, int);
         va_end(vptr);
         enter_panic_mode(code);
     }
 
-    ros_flash(flash_callbacks[type]);
-    ros_puts(ATTRIBUTE_DEFAULT, USTR("     "), false); /* 5 spaces ( log header + space ) */
-    ros_vprintf(ATTRIBUTE_DEFAULT, format, vptr);  
-    ros_putchar(ATTRIBUTE_DEFAULT, '\n');
-}
\ No newline at end of file
+    /* Filtered out before any formatting */
+    if (levels[type] < level)
+        return;
+
+    va_start(vptr, format);
+    vsnprintf(line, sizeof(line), format, vptr);
+    va_end(vptr);
+
+    const uint16_t hash = message_hash(type, line);
+
+    if ((hash == last.hash) && (type == last.type)) {
+        if (last.repeats < UINT8_MAX)
+            last.repeats ++;
+        return;
+    }
+
+    if (!bucket_take(&buckets[type])) {
+        if (buckets[type].dropped < UINT8_MAX)
+            buckets[type].dropped ++;
+        return;
+    }
+
+    log_summary(false);
+    last.hash = hash;
+    last.type = type;
+
+    log_show(type, line);
+}
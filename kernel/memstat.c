@@ -0,0 +1,148 @@
+#include <inttypes.h>
+#include <stdbool.h>
+
+#include <avr/io.h>
+
+#include "memstat.h"
+#include "sched.h"
+#include "pool.h"
+#include "video.h"
+#include "shell.h"
+#include "log.h"
+#include "ros.h"
+
+/* From linker script */
+extern uint8_t __data_start, __data_end, __bss_start, __bss_end, _end;
+
+volatile uint16_t memstat_isr_sp[MEMSTAT_ISRS_NUMBER] = {
+    [0 ... MEMSTAT_ISRS_NUMBER - 1] = RAMEND
+};
+
+static uint8_t *window_base = NULL, *window_bottom = NULL;
+static uint8_t *lowest_dirty = (uint8_t *)RAMEND;
+static uint16_t task_depth[SCHED_TASKS_CAP] = { 0 };
+static uint16_t idle_depth = 0;
+static bool warned = false;
+
+/* Fills everything between .bss and top of RAM before C runtime starts, only registers are touched */
+void __attribute__((naked, used, section(".init1"))) memstat_paint(void) {
+    __asm__ volatile (
+        "    ldi r30, lo8(_end)      \n"
+        "    ldi r31, hi8(_end)      \n"
+        "    ldi r24, %0             \n"
+        "    ldi r25, hi8(__stack)   \n"
+        "    rjmp 2f                 \n"
+        "1:  st Z+, r24              \n"
+        "2:  cpi r30, lo8(__stack)   \n"
+        "    cpc r31, r25            \n"
+        "    brlo 1b                 \n"
+        "    breq 1b                 \n"
+        :: "M" (MEMSTAT_CANARY)
+    );
+}
+
+/* First byte, which lost its canary, scanning up from bottom */
+static uint8_t *first_dirty(uint8_t *from, uint8_t *to) {
+    while ((from < to) && (*from == MEMSTAT_CANARY))
+        from++;
+
+    return from;
+}
+
+static inline void note_dirty(uint8_t *p) {
+    if (p < lowest_dirty)
+        lowest_dirty = p;
+}
+
+/* Window is painted from current frame down, so the task's own usage can be read back */
+void memstat_task_enter(void) {
+    uint8_t *dirty;
+
+    if (!window_base) {
+        window_base = (uint8_t *)SP;
+        window_bottom = ((window_base - &_end) > MEMSTAT_WINDOW) ? window_base - MEMSTAT_WINDOW : &_end;
+    }
+
+    /* Whatever ran since last task ( ISRs on idle ) is accounted to idle */
+    dirty = first_dirty(window_bottom, window_base);
+    if ((uint16_t)(window_base - dirty) > idle_depth)
+        idle_depth = (uint16_t)(window_base - dirty);
+
+    note_dirty(dirty);
+
+    for (uint8_t *p = dirty; p < window_base; p++)
+        *p = MEMSTAT_CANARY;
+}
+
+void memstat_task_leave(uint8_t task) {
+    uint8_t *dirty = first_dirty(window_bottom, window_base);
+
+    if ((uint16_t)(window_base - dirty) > task_depth[task])
+        task_depth[task] = (uint16_t)(window_base - dirty);
+
+    note_dirty(dirty);
+}
+
+/* Bytes between .bss and deepest stack point ever reached */
+uint16_t memstat_headroom(void) {
+    uint8_t *dirty = first_dirty(&_end, (uint8_t *)SP);
+
+    note_dirty(dirty);
+    return (uint16_t)(lowest_dirty - &_end);
+}
+
+static void __callback memstat_task(struct Task *self) {
+    TASK_BEGIN(self);
+
+    for (;;) {
+        TASK_SLEEP(self, MEMSTAT_CHECK_TICKS);
+
+        /* Like log summaries, only while a command runs: otherwise it lands on the prompt line.
+           Headroom is a low watermark, so a warning held back is still due next time */
+        if (!warned && (sys_mode == SYSTEM_MODE_BUSY) && (memstat_headroom() < MEMSTAT_HEADROOM_WARN)) {
+            warned = true;
+            ros_log(LOG_TYPE_WARNING, "Low stack: %d", memstat_headroom());
+        }
+    }
+
+    TASK_END(self);
+}
+
+void memstat_init(void) {
+    sched_spawn(memstat_task);
+}
+
+int shell_cmd_mem(uint8_t argc, char **argv) {
+    static const char *const isr_names[MEMSTAT_ISRS_NUMBER] = {
+        [MEMSTAT_ISR_INT0]   = "INT0",
+        [MEMSTAT_ISR_TIMER0] = "TIMER0",
+        [MEMSTAT_ISR_TWI]    = "TWI",
+    };
+    uint16_t pool_used = 0, pool_total = 0;
+
+    (void) argc;
+    (void) argv;
+
+    for (uint8_t i = 0; i < POOLS_NUMBER; i++) {
+        const struct Pool *pool = pool_info(i);
+        pool_used += (uint16_t)pool->used * pool->block_size;
+        pool_total += (uint16_t)pool->count * pool->block_size;
+    }
+
+    /* Static map, then dynamic usage: depths are bytes below RAMEND */
+    ros_printf(ATTRIBUTE_DEFAULT, "Data\t%d\n", (int)(&__data_end - &__data_start));
+    ros_printf(ATTRIBUTE_DEFAULT, "Bss\t%d\n", (int)(&__bss_end - &__bss_start));
+    ros_printf(ATTRIBUTE_DEFAULT, "Pools\t%d/%d\n", pool_used, pool_total);
+    ros_printf(ATTRIBUTE_DEFAULT, "Stack\t%d\n", (int)(RAMEND - SP));
+    ros_printf(ATTRIBUTE_DEFAULT, "Free\t%d\n", memstat_headroom());
+
+    for (uint8_t i = 0; i < MEMSTAT_ISRS_NUMBER; i++)
+        ros_printf(ATTRIBUTE_DEFAULT, "%s\t%d\n", isr_names[i], (int)(RAMEND - memstat_isr_sp[i]));
+
+    ros_printf(ATTRIBUTE_DEFAULT, "Idle\t+%d\n", idle_depth);
+    for (uint8_t i = 0; i < SCHED_TASKS_CAP; i++)
+        if (task_depth[i])
+            ros_printf(ATTRIBUTE_DEFAULT, "Task%d\t+%d\n", i, task_depth[i]);
+
+    return 0;
+}
@@ -0,0 +1,101 @@
+#include <stddef.h>
+#include <stdbool.h>
+#include <inttypes.h>
+#include <string.h>
+
+#include "pool.h"
+
+#define POOL(name, size, count, reclaim) static_assert( (count) <= POOL_BLOCKS_CAP );
+#include "pool.def"
+#undef POOL
+
+/* Reclaim hooks live in their subsystems */
+#define POOL(name, size, count, reclaim) void reclaim(void);
+#include "pool.def"
+#undef POOL
+
+#define POOL(name, size, count, reclaim) static uint8_t storage_##name[(size) * (count)];
+#include "pool.def"
+#undef POOL
+
+#define POOL(name, bytes, blocks, hook) [POOL_##name] = {   \
+    .storage = storage_##name,                              \
+    .bitmap = 0,                                            \
+    .block_size = (bytes),                                  \
+    .count = (blocks),                                      \
+    .reclaim = hook                                         \
+},
+static struct Pool pools[POOLS_NUMBER] = {
+    #include "pool.def"
+};
+#undef POOL
+
+void pool_no_reclaim(void) { }
+
+/* Lowest clear bit: O(1) on a 16-bit word */
+static inline uint8_t lowest_free(uint16_t bitmap) {
+    return (uint8_t)__builtin_ctz((unsigned)(uint16_t)~bitmap);
+}
+
+/* ISR-safe */
+void *pool_alloc(enum Pool_Id id) {
+    struct Pool *pool = &pools[id];
+    void *block = NULL;
+
+    POOL_ATOMIC() {
+        const uint8_t i = (pool->used < pool->count) ? lowest_free(pool->bitmap) : POOL_END;
+
+        if (i < pool->count) {
+            pool->bitmap |= (uint16_t)(1u << i);
+            block = pool->storage + (uint16_t)i * pool->block_size;
+
+            if (++pool->used > pool->high_water)
+                pool->high_water = pool->used;
+        } else if (pool->failures < UINT8_MAX)
+            pool->failures ++;
+    }
+
+    return block;
+}
+
+/* ISR-safe */
+void pool_free(enum Pool_Id id, void *block) {
+    struct Pool *pool = &pools[id];
+    uint8_t i;
+
+    if (!block)
+        return;
+
+    i = (uint8_t)(((uint8_t *)block - pool->storage) / pool->block_size);
+
+    POOL_ATOMIC() {
+        if (pool->bitmap & (1u << i)) {
+            pool->bitmap &= (uint16_t)~(1u << i);
+            pool->used --;
+        }
+    }
+}
+
+/* Asks cache-like owners to give blocks back */
+void pool_reclaim(enum Pool_Id id) {
+    pools[id].reclaim();
+}
+
+/* Index of first used block at or after from, POOL_END if none */
+uint8_t pool_next(enum Pool_Id id, uint8_t from) {
+    const struct Pool *pool = &pools[id];
+
+    for (; from < pool->count; from++)
+        if (pool->bitmap & (1u << from))
+            return from;
+
+    return POOL_END;
+}
+
+void *pool_block(enum Pool_Id id, uint8_t i) {
+    return pools[id].storage + (uint16_t)i * pools[id].block_size;
+}
+
+const struct Pool *pool_info(enum Pool_Id id) {
+    return &pools[id];
+}
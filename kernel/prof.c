@@ -0,0 +1,143 @@
+#include <inttypes.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <util/atomic.h>
+
+#include "prof.h"
+#include "video.h"
+#include "shell.h"
+#include "log.h"
+#include "ros.h"
+
+#define PROBE(name) #name,
+static const char *const names[PROF_PROBES_NUMBER] = {
+    #include "prof.def"
+};
+#undef PROBE
+
+static struct Prof_Counter counters[PROF_PROBES_NUMBER];
+static volatile uint16_t overflows = 0;
+static uint16_t overhead = 0;           /* Cycles of empty BEGIN/END pair */
+
+void prof_reset(void) {
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        memset(counters, 0, sizeof(counters));
+        for (uint8_t i = 0; i < PROF_PROBES_NUMBER; i++)
+            counters[i].min = UINT32_MAX;
+    }
+}
+
+#ifdef PROFILE
+
+/* TIMER1 free-runs at F_CPU, overflow count extends it to 32 bits */
+void prof_init(void) {
+    cli();
+    TCCR1A = 0;
+    TCCR1B = BIT(CS10);
+    TCNT1 = 0;
+    TIMSK1 = BIT(TOIE1);
+    sei();
+
+    prof_reset();
+
+    /* Calibrate the cost of probe itself */
+    const uint32_t begin = prof_now();
+    overhead = (uint16_t)(prof_now() - begin);
+}
+
+/* Safe in ISR and task context */
+uint32_t prof_now(void) {
+    uint16_t high, low;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        low = TCNT1;
+        high = overflows;
+
+        /* Overflow happened, but its ISR hasn't run yet */
+        if ((TIFR1 & BIT(TOV1)) && (low < 0x8000))
+            high ++;
+    }
+
+    return ((uint32_t)high << 16) | low;
+}
+
+ISR(TIMER1_OVF_vect) {
+    overflows ++;
+}
+
+#else
+
+void prof_init(void) {
+    prof_reset();
+}
+
+uint32_t prof_now(void) {
+    return 0;
+}
+
+#endif /* PROFILE */
+
+void prof_account(enum Prof_Probe probe, uint32_t begin) {
+    uint32_t cycles = prof_now() - begin;
+    struct Prof_Counter *c = &counters[probe];
+
+    cycles = (cycles > overhead) ? cycles - overhead : 0;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        c->total += cycles;
+        c->count ++;
+
+        if (cycles < c->min)
+            c->min = cycles;
+        if (cycles > c->max)
+            c->max = cycles;
+    }
+}
+
+/* ros_printf has 16-bit %d only, long times switch to milliseconds */
+static void print_time(uint32_t cycles) {
+    const uint32_t us = cycles / PROF_CYCLES_PER_US;
+
+    if (us < 10000)
+        ros_printf(ATTRIBUTE_DEFAULT, " %d", (int)us);
+    else
+        ros_printf(ATTRIBUTE_DEFAULT, " %dm", (int)(us / 1000));
+}
+
+int shell_cmd_prof(uint8_t argc, char **argv) {
+    struct Prof_Counter c;
+
+    if (argc == 2) {
+        if (strcmp(argv[1], "reset")) {
+            ros_log(LOG_TYPE_ERROR, "Usage: help prof");
+            return -1;
+        }
+
+        prof_reset();
+        return 0;
+    }
+
+#ifndef PROFILE
+    ros_puts(ATTRIBUTE_DEFAULT, USTR("Built without PROFILE"), true);
+#endif
+
+    /* name count, then min avg max in us ( 'm' = ms ) */
+    for (uint8_t i = 0; i < PROF_PROBES_NUMBER; i++) {
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+            c = counters[i];
+
+        ros_printf(ATTRIBUTE_DEFAULT, "%s\t%d\n", names[i], c.count);
+        if (!c.count)
+            continue;
+
+        print_time(c.min);
+        print_time(c.total / c.count);
+        print_time(c.max);
+        ros_putchar(ATTRIBUTE_DEFAULT, '\n');
+    }
+
+    return 0;
+}
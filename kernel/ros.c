@@ -8,12 +8,17 @@
 #include <avr/io.h>
 #include <avr/interrupt.h>
 #include <avr/pgmspace.h>
+#include <util/atomic.h>
 
 #include "spi.h"
 #include "st7735.h"
 
 #include "video.h"
 #include "keyboard.h"
+#include "uart.h"
+#include "history.h"
+#include "pool.h"
+#include "shell.h"
 #include "log.h"
 #include "ros.h"
 
@@ -40,71 +45,335 @@ void ros_set_pin_direction(volatile uint8_t *port, volatile uint8_t *ddr, int pi
     }
 }
 
-struct Input_Buffer ibuffer = { 0 };
+/* Blocks in SYSTEM_MODE_IDLE until a key is pressed or a console byte arrives. Nothing is
+   taken from UART ring, so a pause does not eat scripted input typed ahead */
+void ros_pause(void) {
+    sys_mode = SYSTEM_MODE_IDLE;
 
-static void return_to_input_mode(void) {
-    sys_mode = SYSTEM_MODE_INPUT;
+    while (idle_key == INVALID_KEY)
+        keyboard_idle_poll();
+
+    idle_key = INVALID_KEY;
+}
+
+/* Blocks in SYSTEM_MODE_IDLE until a key comes from keyboard or UART console, -1 if it has no character */
+int ros_wait_key(void) {
+    int ch;
+
+    ros_apply_output_entrys();
+
+    /* Console bytes typed ahead are taken in order. Ring is checked in one step with
+       going idle, so a byte that comes in between still wakes the system */
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        if ((ch = uart_getc()) < 0)
+            sys_mode = SYSTEM_MODE_IDLE;
+    }
+
+    if (ch >= 0)
+        return ch;
+
+    while (idle_key == INVALID_KEY)
+        keyboard_idle_poll();
+
+    /* UART byte that woke the system is left in its ring */
+    if ((ch = uart_getc()) < 0) {
+        switch (idle_key) {
+        case VK_ENTER:     ch = '\n'; break;
+        case VK_BACKSPACE: ch = '\b'; break;
+        default:           ch = vk_as_char(idle_key); break;
+        }
+    }
+
+    idle_key = INVALID_KEY;
+    return ch;
+}
+
+struct Input_Buffer ibuffer = { .gap_begin = 0, .gap_end = INPUT_BUFFER_CAP };
+
+/* Last cell is kept free, so the line can always be terminated in place */
+static bool input_buffer_insert(char ch) {
+    if (ibuffer.gap_end - ibuffer.gap_begin <= 1)
+        return false;
+
+    ibuffer.raw[ibuffer.gap_begin ++] = ch;
+    return true;
+}
+
+static bool input_buffer_erase(void) {
+    if (!ibuffer.gap_begin)
+        return false;
+
+    ibuffer.gap_begin --;
+    return true;
+}
+
+static bool input_buffer_left(void) {
+    if (!ibuffer.gap_begin)
+        return false;
+
+    ibuffer.raw[-- ibuffer.gap_end] = ibuffer.raw[-- ibuffer.gap_begin];
+    return true;
+}
+
+static bool input_buffer_right(void) {
+    if (ibuffer.gap_end >= INPUT_BUFFER_CAP)
+        return false;
+
+    ibuffer.raw[ibuffer.gap_begin ++] = ibuffer.raw[ibuffer.gap_end ++];
+    return true;
+}
+
+/* Moves gap to the end, so line is contiguous in raw[0, gap_begin) */
+static void input_buffer_flatten(void) {
+    const unsigned short tail = INPUT_BUFFER_CAP - ibuffer.gap_end;
+
+    memmove(ibuffer.raw + ibuffer.gap_begin, ibuffer.raw + ibuffer.gap_end, tail);
+    ibuffer.gap_begin += tail;
+    ibuffer.gap_end = INPUT_BUFFER_CAP;
+}
+
+/* -1 - line being edited, 0 - newest history entry */
+static int history_age = -1;
+
+/* Line being edited, kept in a borrowed page while history is browsed: length, then text */
+static uint8_t *draft = NULL;
+
+static_assert( HISTORY_ENTRY_CAP < POOL_BLOCK_SIZE(page) );
+
+/* Flattened line only. Too long a line or no free page: browsing is refused, nothing is lost */
+static bool draft_save(void) {
+    const unsigned short len = ibuffer.gap_begin;
+
+    if (len > POOL_BLOCK_SIZE(page) - 1)
+        return false;
+
+    if (!(draft = pool_alloc(POOL_page))) {
+        pool_reclaim(POOL_page);
+        if (!(draft = pool_alloc(POOL_page)))
+            return false;
+    }
+
+    draft[0] = (uint8_t)len;
+    memcpy(draft + 1, ibuffer.raw, len);
+    return true;
+}
+
+static void draft_drop(void) {
+    if (draft)
+        pool_free(POOL_page, draft);
+    draft = NULL;
+}
+
+/* Same contract as history_recall() */
+static int draft_restore(uint8_t *first_diff) {
+    const uint8_t len = draft ? draft[0] : 0;
+
+    *first_diff = len;
+    for (uint8_t i = 0; i < len; i++) {
+        if ((ibuffer.raw[i] != (char)draft[1 + i]) && (*first_diff == len))
+            *first_diff = i;
+        ibuffer.raw[i] = (char)draft[1 + i];
+    }
 
-    memset(ibuffer.raw, 0, INPUT_BUFFER_CAP);
-    ibuffer.cursor = 0;
+    draft_drop();
+    return len;
+}
+
+static void history_show(int age) {
+    const unsigned short old_len = INPUT_BUFFER_LENGTH(ibuffer);
+    uint8_t first_diff = 0;
+    int len = 0;
+
+    input_buffer_flatten();
+
+    if ((age >= 0) && (history_age < 0) && !draft_save())
+        return;
+
+    if (age < 0)
+        len = draft_restore(&first_diff);
+    else if ((len = history_recall(age, ibuffer.raw, HISTORY_ENTRY_CAP, &first_diff)) < 0) {
+        if (history_age < 0)
+            draft_drop();
+        return;
+    }
+
+    history_age = age;
+    ibuffer.gap_begin = len;
+
+    /* raw[] past the old line holds stale bytes, they may match the recalled entry but are not on screen */
+    if (first_diff > old_len)
+        first_diff = (uint8_t)old_len;
+
+    /* Repaint only the part of the line that has changed */
+    ros_put_input_buffer(first_diff, (old_len > len) ? (old_len - len) : 0);
+}
+
+/* Prompt is printed while still busy, so it reaches console mirror too */
+static void return_to_input_mode(void) {
+    ibuffer.gap_begin = 0;
+    ibuffer.gap_end = INPUT_BUFFER_CAP;
+    history_age = -1;
+    draft_drop();
 
     ros_put_prompt();
+    sys_mode = SYSTEM_MODE_INPUT;
     enable_cursor();
 }
 
-void __callback keyboard_input(enum Virtual_Key vk){
-    int ch = vk_as_char(vk);
-
-    if ((ch < 0) || (ibuffer.cursor >= INPUT_BUFFER_CAP - 1))
+static void input_char(char ch) {
+    if (!input_buffer_insert(ch))
         return;
 
-    memmove(ibuffer.raw + ibuffer.cursor + 1, ibuffer.raw + ibuffer.cursor, INPUT_BUFFER_CAP - ibuffer.cursor - 1);
-    ibuffer.raw[ibuffer.cursor ++] = (char)ch;
+    /* Inserted character + shifted tail ( only one cell at the end of line ) */
+    ros_put_input_buffer(ibuffer.gap_begin - 1, 0);
+}
+
+void __callback keyboard_input(enum Virtual_Key vk){
+    int ch = vk_as_char(vk);
 
-    ros_put_input_buffer(ibuffer.cursor - 1, 0);
+    if (ch >= 0)
+        input_char((char)ch);
 }
 
 /* Keyboard callbacks are only active in SYSTEM_MODE_INPUT */
 void __callback keyboard_nonprintable_right_arrow(void){
-    ibuffer.cursor += ((ibuffer.cursor < (INPUT_BUFFER_CAP - 1)) && (ibuffer.raw[ibuffer.cursor] != '\0'));
-    ros_put_input_buffer(ibuffer.cursor - 1, 0);
+    if (input_buffer_right())
+        ros_put_input_char(ibuffer.gap_begin - 1);
 }
 
 void __callback keyboard_nonprintable_left_arrow(void){
-    ibuffer.cursor -= (ibuffer.cursor > 0);
-    ros_put_input_buffer(ibuffer.cursor, 1);
+    if (input_buffer_left())
+        ros_put_input_char(ibuffer.gap_begin + 1);
+}
+
+void __callback keyboard_nonprintable_up_arrow(void){
+    if (history_age + 1 < history_size())
+        history_show(history_age + 1);
+}
+
+void __callback keyboard_nonprintable_down_arrow(void){
+    if (history_age >= 0)
+        history_show(history_age - 1);
 }
 
-void __callback keyboard_nonprintable_down_arrow(void){ __asm__ __volatile__ ("nop"); }
-void __callback keyboard_nonprintable_up_arrow(void){ __asm__ __volatile__ ("nop"); }
 void __callback keyboard_nonprintable_control(void) { __asm__ __volatile__ ("nop"); }
 
 void __callback keyboard_nonprintable_enter(void){
     disable_cursor();
     sys_mode = SYSTEM_MODE_BUSY;
-    ros_putchar(ATTRIBUTE_DEFAULT, '\n');
+    input_buffer_flatten();
+
+    /* Arguments are parsed in place, there is always a free cell for terminator */
+    ibuffer.raw[ibuffer.gap_begin] = '\0';
+
+    /* Console mirror gets the accepted line, editing itself is screen-only */
+    ros_mirror_puts(ibuffer.raw);
+    ros_put_input_newline();
+
+    history_push(ibuffer.raw, (uint8_t)((ibuffer.gap_begin > HISTORY_ENTRY_CAP) ? 0 : ibuffer.gap_begin));
+    shell_execute(ibuffer.raw);
 
-    for (int i = 0; i < 15; i++)
-        ros_log(LOG_TYPE_INFO, "Test");
-    
     return_to_input_mode();
 }
 
 void __callback keyboard_nonprintable_backspace(void){
-    if (!ibuffer.cursor) return;
-
-    memmove(ibuffer.raw + ibuffer.cursor - 1, ibuffer.raw + ibuffer.cursor, INPUT_BUFFER_CAP - ibuffer.cursor - 1);
-    ibuffer.cursor --;
+    if (!input_buffer_erase())
+        return;
 
-    ros_put_input_buffer(ibuffer.cursor, 2);
+    ros_put_input_buffer(ibuffer.gap_begin, 1);
 }
 
 void __callback keyboard_nonprintable_tab(void){
-    memmove(ibuffer.raw + ibuffer.cursor + 2, ibuffer.raw + ibuffer.cursor, INPUT_BUFFER_CAP - ibuffer.cursor - 2);
-    memcpy(ibuffer.raw + ibuffer.cursor, "  ", 2);
-    ibuffer.cursor += 2;
+    char ext[SHELL_NAME_CAP];
+    const unsigned short disp = ibuffer.gap_begin;
+    int matches;
+
+    /* Only command name is completed, text before cursor is contiguous in gap buffer */
+    if ((disp >= SHELL_NAME_CAP) || (memchr(ibuffer.raw, ' ', disp) != NULL))
+        return;
+
+    if (!(matches = shell_complete(ibuffer.raw, (uint8_t)disp, ext, sizeof(ext))))
+        return;
+
+    for (const char *p = ext; *p && input_buffer_insert(*p); p++)
+        ;
+
+    if ((matches == 1) && (INPUT_BUFFER_UNDER(ibuffer) != ' '))
+        input_buffer_insert(' ');
+
+    if (ibuffer.gap_begin != disp) {
+        ros_put_input_buffer(disp, 0);
+        return;
+    }
+
+    if (matches == 1)
+        return;
+
+    /* Ambiguous prefix: list candidates and redraw the line below */
+    disable_cursor();
+    sys_mode = SYSTEM_MODE_BUSY;
+    ros_put_input_newline();
+    shell_list_matches(ibuffer.raw, (uint8_t)disp);
+
+    ros_put_prompt();
+    sys_mode = SYSTEM_MODE_INPUT;
+    ros_put_input_buffer(0, 0);
+    enable_cursor();
+}
+
+/* UART console: CR, LF or CR LF ends line, ANSI arrows, BS or DEL erases */
+void __callback console_input(char ch){
+    static enum { ESCAPE_NONE = 0, ESCAPE_ESC, ESCAPE_CSI } escape = ESCAPE_NONE;
+    static char last = '\0';
+    const char prev = last;
 
-    ros_put_input_buffer(ibuffer.cursor - 2, 0);
+    last = ch;
+
+    if (escape == ESCAPE_ESC) {
+        escape = (ch == '[') ? ESCAPE_CSI : ESCAPE_NONE;
+        return;
+    }
+
+    if (escape == ESCAPE_CSI) {
+        escape = ESCAPE_NONE;
+
+        switch (ch) {
+        case 'A': keyboard_nonprintable_up_arrow(); break;
+        case 'B': keyboard_nonprintable_down_arrow(); break;
+        case 'C': keyboard_nonprintable_right_arrow(); break;
+        case 'D': keyboard_nonprintable_left_arrow(); break;
+        }
+        return;
+    }
+
+    switch (ch) {
+    case '\033':
+        escape = ESCAPE_ESC;
+        break;
+
+    case '\n':
+        if (prev != '\r')
+            keyboard_nonprintable_enter();
+        break;
+
+    case '\r':
+        keyboard_nonprintable_enter();
+        break;
+
+    case '\b':
+    case 0x7F:
+        keyboard_nonprintable_backspace();
+        break;
+
+    case '\t':
+        keyboard_nonprintable_tab();
+        break;
+
+    default:
+        if ((ch >= ' ') && (ch <= '~'))
+            input_char(ch);
+        break;
+    }
 }
 
 ISR(BADISR_vect) {
@@ -0,0 +1,141 @@
+#include <inttypes.h>
+#include <stdbool.h>
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#include <util/atomic.h>
+
+#include "sched.h"
+#include "memstat.h"
+#include "trace.h"
+#include "log.h"
+#include "ros.h"
+
+static struct Task tasks[SCHED_TASKS_CAP] = { 0 };
+static uint8_t tasks_number = 0;
+
+static volatile uint16_t ticks = 0;
+static volatile uint8_t pending_events = 0;
+
+/* Run queue: one bit per task, lower index - checked first */
+static uint8_t ready = 0;
+static uint8_t last = SCHED_TASKS_CAP - 1;
+
+struct Task *sched_spawn(Task_Routine routine) {
+    if (tasks_number >= SCHED_TASKS_CAP)
+        return NULL;
+
+    tasks[tasks_number] = (struct Task){ .routine = routine, .state = TASK_STATE_READY };
+    ready |= BIT(tasks_number);
+    return &tasks[tasks_number ++];
+}
+
+uint16_t sched_now(void) {
+    uint16_t now;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+        now = ticks;
+
+    return now;
+}
+
+void sched_sleep(struct Task *task, uint16_t n) {
+    task->wake_tick = sched_now() + n;
+    task->state = TASK_STATE_SLEEPING;
+}
+
+void sched_wait(struct Task *task, uint8_t events) {
+    task->events = events;
+    task->state = TASK_STATE_WAITING;
+}
+
+/* Both are ISR-safe */
+void sched_signal(uint8_t events) {
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+        pending_events |= events;
+}
+
+void sched_tick(void) {
+    ticks ++;
+    pending_events |= SCHED_EVENT_TICK;
+}
+
+static void wake_tasks(void) {
+    uint8_t events;
+    const uint16_t now = sched_now();
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        events = pending_events;
+        pending_events = 0;
+    }
+
+    for (uint8_t i = 0; i < tasks_number; i++) {
+        struct Task *t = &tasks[i];
+
+        switch (t->state) {
+        case TASK_STATE_SLEEPING:
+            if ((int16_t)(now - t->wake_tick) < 0)
+                continue;
+            break;
+
+        case TASK_STATE_WAITING:
+            if (!(t->events & events))
+                continue;
+            t->events &= events;
+            break;
+
+        case TASK_STATE_READY:
+            break;
+
+        default:
+            continue;
+        }
+
+        t->state = TASK_STATE_READY;
+        ready |= BIT(i);
+    }
+}
+
+static void idle(void) {
+    set_sleep_mode(SLEEP_MODE_IDLE);
+
+    /* Any interrupt between check and sleep would be lost, so 'sei' goes right before 'sleep' */
+    cli();
+    if (!pending_events) {
+        sleep_enable();
+        sei();
+        sleep_cpu();
+        sleep_disable();
+    }
+    sei();
+}
+
+void __attribute__((noreturn)) sched_run(void) {
+    for (;;) {
+        wake_tasks();
+
+        if (!ready) {
+            idle();
+            continue;
+        }
+
+        /* Round robin over ready tasks, starting after the last one */
+        uint8_t i = last;
+        do {
+            i = (i + 1) % SCHED_TASKS_CAP;
+        } while (!(ready & BIT(i)));
+
+        ready &= ~BIT(i);
+        last = i;
+
+        memstat_task_enter();
+        TRACE_EVENT(TASK_BEGIN, i);
+        (tasks[i].routine)(&tasks[i]);
+        TRACE_EVENT(TASK_END, i);
+        memstat_task_leave(i);
+
+        if (tasks[i].state == TASK_STATE_READY)
+            ready |= BIT(i);
+    }
+}
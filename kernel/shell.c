@@ -0,0 +1,234 @@
+#include <inttypes.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <avr/pgmspace.h>
+
+#include "video.h"
+#include "history.h"
+#include "pool.h"
+#include "shell.h"
+#include "log.h"
+#include "ros.h"
+
+/* Generated from commands.def by tools/shell_gen */
+#include "shell_table.h"
+
+#define PREFIX_NAME(i)      (shell_commands[pgm_read_byte(&shell_prefix_index[(i)])].name)
+
+static struct Shell_Command command_read(uint8_t slot) {
+    struct Shell_Command cmd;
+    memcpy_P(&cmd, &shell_commands[slot], sizeof(cmd));
+    return cmd;
+}
+
+/* O(1): one displacement lookup, one hash, one name compare */
+static int command_lookup(const char *name, struct Shell_Command *cmd) {
+    const size_t len = strlen(name);
+
+    if (len >= SHELL_NAME_CAP)
+        return -1;
+
+    const uint8_t d = pgm_read_byte(&shell_hash_displace[shell_hash(name, len, 0) % SHELL_HASH_BUCKETS]);
+    const uint8_t slot = shell_hash(name, len, d) % SHELL_COMMANDS_NUMBER;
+
+    if (strncmp_P(name, shell_commands[slot].name, SHELL_NAME_CAP))
+        return -1;
+
+    *cmd = command_read(slot);
+    return slot;
+}
+
+/* Splits line in place, argv points directly into the input buffer */
+static uint8_t split_arguments(char *line, char **argv) {
+    uint8_t argc = 0;
+
+    while (*line) {
+        while (*line == ' ')
+            *line++ = '\0';
+
+        if (!*line)
+            break;
+
+        if (argc == SHELL_ARGS_CAP)
+            return SHELL_ARGS_CAP + 1;
+
+        if (*line == '\"') {
+            argv[argc++] = ++line;
+            while (*line && (*line != '\"'))
+                line++;
+
+            if (*line)
+                *line++ = '\0';
+            continue;
+        }
+
+        argv[argc++] = line;
+        while (*line && (*line != ' '))
+            line++;
+    }
+
+    return argc;
+}
+
+int shell_execute(char *line) {
+    char *argv[SHELL_ARGS_CAP];
+    struct Shell_Command cmd;
+    const uint8_t argc = split_arguments(line, argv);
+
+    if (!argc)
+        return 0;
+
+    if (argc > SHELL_ARGS_CAP) {
+        ros_log(LOG_TYPE_ERROR, "Too many arguments");
+        return -1;
+    }
+
+    if (command_lookup(argv[0], &cmd) < 0) {
+        ros_log(LOG_TYPE_ERROR, "Bad command: %s", argv[0]);
+        return -1;
+    }
+
+    if ((argc - 1 < cmd.min_args) || (argc - 1 > cmd.max_args)) {
+        ros_log(LOG_TYPE_ERROR, "Usage: help %s", argv[0]);
+        return -1;
+    }
+
+    return cmd.handler(argc, argv);
+}
+
+/* Index of first command, which is not less than prefix */
+static uint8_t prefix_lower_bound(const char *prefix, uint8_t len) {
+    uint8_t lo = 0, hi = SHELL_COMMANDS_NUMBER;
+
+    while (lo < hi) {
+        const uint8_t mid = (lo + hi) / 2;
+
+        if (strncmp_P(prefix, PREFIX_NAME(mid), len) > 0)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+
+    return lo;
+}
+
+/* Returns number of matching commands, ext receives their longest common continuation */
+int shell_complete(const char *prefix, uint8_t len, char *ext, uint8_t ext_size) {
+    const uint8_t first = prefix_lower_bound(prefix, len);
+    uint8_t last = first;
+
+    while ((last < SHELL_COMMANDS_NUMBER) && !strncmp_P(prefix, PREFIX_NAME(last), len))
+        last ++;
+
+    *ext = '\0';
+    if (last == first)
+        return 0;
+
+    /* Names are sorted, so common prefix of the range is common prefix of its ends */
+    const char *a = PREFIX_NAME(first) + len, *b = PREFIX_NAME(last - 1) + len;
+    uint8_t n = 0;
+
+    for (char ch; (n < ext_size - 1) && ((ch = pgm_read_byte(a + n)) != '\0') && (ch == (char)pgm_read_byte(b + n)); n++)
+        ext[n] = ch;
+
+    ext[n] = '\0';
+    return last - first;
+}
+
+void shell_list_matches(const char *prefix, uint8_t len) {
+    char name[SHELL_NAME_CAP];
+
+    for (uint8_t i = prefix_lower_bound(prefix, len); (i < SHELL_COMMANDS_NUMBER) && !strncmp_P(prefix, PREFIX_NAME(i), len); i++) {
+        memcpy_P(name, PREFIX_NAME(i), sizeof(name));
+        ros_puts(ATTRIBUTE_DEFAULT, USTR(name), false);
+        ros_putchar(ATTRIBUTE_DEFAULT, ' ');
+    }
+
+    ros_putchar(ATTRIBUTE_DEFAULT, '\n');
+}
+
+/* --------------- Builtin commands --------------- */
+static void put_usage(const struct Shell_Command *cmd) {
+    ros_printf(ATTRIBUTE_DEFAULT, "%s %d-%d: ", cmd->name, cmd->min_args, cmd->max_args);
+    ros_puts_P(ATTRIBUTE_DEFAULT, USTR(cmd->help), true);
+}
+
+int shell_cmd_help(uint8_t argc, char **argv) {
+    struct Shell_Command cmd;
+
+    if (argc > 1) {
+        if (command_lookup(argv[1], &cmd) < 0) {
+            ros_log(LOG_TYPE_ERROR, "Bad command: %s", argv[1]);
+            return -1;
+        }
+
+        put_usage(&cmd);
+        return 0;
+    }
+
+    for (uint8_t i = 0; i < SHELL_COMMANDS_NUMBER; i++) {
+        cmd = command_read(pgm_read_byte(&shell_prefix_index[i]));
+        ros_puts(ATTRIBUTE_DEFAULT, USTR(cmd.name), false);
+        ros_putchar(ATTRIBUTE_DEFAULT, '\t');
+        ros_puts_P(ATTRIBUTE_DEFAULT, USTR(cmd.help), true);
+    }
+
+    return 0;
+}
+
+int shell_cmd_clear(uint8_t argc, char **argv) {
+    (void) argc;
+    (void) argv;
+
+    clear_screen(0x0000);
+    return 0;
+}
+
+int shell_cmd_echo(uint8_t argc, char **argv) {
+    for (uint8_t i = 1; i < argc; i++) {
+        ros_puts(ATTRIBUTE_DEFAULT, USTR(argv[i]), false);
+        ros_putchar(ATTRIBUTE_DEFAULT, ' ');
+    }
+
+    ros_putchar(ATTRIBUTE_DEFAULT, '\n');
+    return 0;
+}
+
+int shell_cmd_history(uint8_t argc, char **argv) {
+    char line[HISTORY_ENTRY_CAP + 1];
+    uint8_t first_diff;
+    int len;
+
+    (void) argc;
+    (void) argv;
+
+    for (int age = history_size() - 1; age >= 0; age--) {
+        if ((len = history_recall(age, line, HISTORY_ENTRY_CAP, &first_diff)) < 0)
+            break;
+
+        line[len] = '\0';
+        ros_puts(ATTRIBUTE_DEFAULT, USTR(line), true);
+    }
+
+    return 0;
+}
+
+int shell_cmd_pool(uint8_t argc, char **argv) {
+    #define POOL(name, size, count, hook) #name,
+    static const char *const names[POOLS_NUMBER] = {
+        #include "pool.def"
+    };
+    #undef POOL
+
+    (void) argc;
+    (void) argv;
+
+    /* Used / high-water / blocks, failed allocations */
+    for (uint8_t i = 0; i < POOLS_NUMBER; i++) {
+        const struct Pool *pool = pool_info(i);
+        ros_printf(ATTRIBUTE_DEFAULT, "%s\t%d/%d/%d !%d\n", names[i], pool->used, pool->high_water, pool->count, pool->failures);
+    }
+
+    return 0;
+}
@@ -0,0 +1,110 @@
+#include <inttypes.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include <avr/io.h>
+#include <util/atomic.h>
+
+#include "trace.h"
+#include "uart.h"
+#include "sched.h"
+#include "video.h"
+#include "shell.h"
+#include "log.h"
+#include "ros.h"
+
+static_assert( (TRACE_RING_CAP & (TRACE_RING_CAP - 1)) == 0 );
+
+#ifdef TRACE
+
+static struct Trace_Record ring[TRACE_RING_CAP];
+static uint8_t head = 0, count = 0, lost = 0;
+static bool frozen = false;
+
+/* Ticks * counts per tick + TIMER0 count, in TRACE_TIME_UNIT_US units */
+static uint16_t trace_time(void) {
+    uint16_t now = sched_now();
+    const uint8_t cnt = TCNT0;
+
+    /* Compare match happened, but its ISR hasn't run yet */
+    if ((TIFR0 & BIT(OCF0A)) && (cnt < OCR0A / 2))
+        now ++;
+
+    return now * (uint16_t)(OCR0A + 1) + cnt;
+}
+
+/* Safe in ISR and task context, oldest record is overwritten */
+void trace_event(enum Trace_Event id, uint8_t arg) {
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        if (!frozen) {
+            ring[head] = (struct Trace_Record){ id, arg, trace_time() };
+            head = (head + 1) & (TRACE_RING_CAP - 1);
+
+            if (count < TRACE_RING_CAP)
+                count ++;
+            else if (lost < UINT8_MAX)
+                lost ++;
+        }
+    }
+}
+
+void trace_clear(void) {
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+        head = count = lost = 0;
+}
+
+/* Recording stops while the ring is sent, so it is not overwritten mid-dump */
+static uint8_t trace_dump(void) {
+    struct Trace_Header header = { .unit_us = TRACE_TIME_UNIT_US };
+    uint8_t first;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        frozen = true;
+        header.count = count;
+        header.lost = lost;
+        first = (head - count) & (TRACE_RING_CAP - 1);
+    }
+
+    memcpy(header.magic, TRACE_MAGIC, sizeof(header.magic));
+    uart_write(&header, sizeof(header));
+
+    for (uint8_t i = 0; i < header.count; i++)
+        uart_write(&ring[(first + i) & (TRACE_RING_CAP - 1)], sizeof(struct Trace_Record));
+
+    trace_clear();
+    frozen = false;
+    return header.count;
+}
+
+#else
+
+void trace_event(enum Trace_Event id, uint8_t arg) {
+    (void) id;
+    (void) arg;
+}
+
+void trace_clear(void) {
+}
+
+#endif /* TRACE */
+
+int shell_cmd_trace(uint8_t argc, char **argv) {
+    if (argc == 2) {
+        if (strcmp(argv[1], "clear")) {
+            ros_log(LOG_TYPE_ERROR, "Usage: help trace");
+            return -1;
+        }
+
+        trace_clear();
+        return 0;
+    }
+
+#ifdef TRACE
+    /* Decode on host with tools/tracedec */
+    ros_printf(ATTRIBUTE_DEFAULT, "%d records sent\n", trace_dump());
+#else
+    ros_puts(ATTRIBUTE_DEFAULT, USTR("Built without TRACE"), true);
+#endif
+
+    return 0;
+}
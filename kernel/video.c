@@ -8,6 +8,7 @@
 #include <avr/io.h>
 #include <avr/interrupt.h>
 #include <avr/pgmspace.h>
+#include <util/atomic.h>
 
 #include "spi.h"
 #include "st7735.h"
@@ -15,6 +16,13 @@
 #define _INCLUDE_FONT
 #include "font.h"
 #include "keyboard.h"
+#include "sched.h"
+#include "defer.h"
+#include "pool.h"
+#include "memstat.h"
+#include "trace.h"
+#include "uart.h"
+#include "prof.h"
 #include "video.h"
 #include "log.h"
 #include "ros.h"
@@ -34,19 +42,32 @@
 #endif
 
 #define OUTPUT_ENTRY_STACK_CAP      20
-#define FLASH_THREAD_STACK_CAP      15
 
-#define OUTPUT_ENTRY_PUSH(e)                                    \
+/* Entries are pushed and popped in task context, but ISR may still panic */
+#define OUTPUT_ENTRY_PUSH(e)                                        \
+do {                                                                \
+    bool pushed = false;                                            \
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {                             \
+        if (output_entry_stack_size <= OUTPUT_ENTRY_STACK_CAP - 1){ \
+            output_entry_stack[output_entry_stack_size ++] = (e);   \
+            pushed = true;                                          \
+        }                                                           \
+    }                                                               \
+    if (pushed)                                                     \
+        break;                                                      \
+    apply_output_entrys();                                          \
+} while( 1 )                                                        \
+
+/* Only the pop itself runs with interrupts disabled */
+#define OUTPUT_ENTRY_POP(e, popped)                             \
 do {                                                            \
-    if (output_entry_stack_size <= OUTPUT_ENTRY_STACK_CAP - 1){ \
-        output_entry_stack[output_entry_stack_size ++] = (e);   \
-        break;                                                  \
+    IRQ_MEASURE_BEGIN();                                        \
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {                         \
+        if (((popped) = (output_entry_stack_size > 0)))         \
+            (e) = output_entry_stack[--output_entry_stack_size];\
     }                                                           \
-    apply_output_entrys();                                      \
-} while( 1 )                                                    \
-
-#define OUTPUT_ENTRY_POP(e)                                     \
-    (e) = output_entry_stack[--output_entry_stack_size]         \
+    IRQ_MEASURE_END(IRQ_PROBE_FLUSH);                           \
+} while( 0 )                                                    \
 
 volatile struct Graphic_Cursor graphic_cursor = {
     .attrib_low = ATTRIBUTE_DEFAULT,
@@ -60,12 +81,14 @@ static volatile v2 cursor = { 0, 0 };
 static struct Output_Entry output_entry_stack[OUTPUT_ENTRY_STACK_CAP] = { 0 };
 static unsigned short output_entry_stack_size = 0;
 
-static struct Flash_Thread flash_thread_stack[FLASH_THREAD_STACK_CAP] = { 0 };
-static unsigned short flash_thread_stack_size = 0;
+/* Flash threads own the whole flash pool, so it can be walked with pool_next() */
+static_assert( sizeof(struct Flash_Thread) <= POOL_BLOCK_SIZE(flash) );
 
 typedef void (* Letter_Lookup_Pointer)(uint8_t *, unsigned char, uint8_t, size_t);
 static volatile Letter_Lookup_Pointer critical_address = NULL;
 
+static void __callback video_task(struct Task *);
+
 static inline __attribute__((always_inline, const)) uint16_t vga_to_rgb565(const uint8_t raw) {
     uint16_t result = 0;
     if (raw & 0x1) result |= 0x1F << 11;
@@ -79,28 +102,40 @@ static void __attribute__((noinline)) letter_lookup(uint8_t *dest, unsigned char
     if (!dest)
         return;
 
-    if (let > (sizeof(font) / 8) - 1)
-        let = (sizeof(font) / 8) - 1;
-
     if (critical_address != letter_lookup)
         HARD_ERROR(FAULT_VIDEO_MEMORY);
 
-    for (unsigned row = 0; (row < LETTER_HEIGHT) && (dest_size > 0); ++row)
-    for (unsigned col = 0; (col < LETTER_WIDTH) && (dest_size > 0); ++col, dest_size -= 2){
-        
-        bool underline = (!!BIT_EXT(attrib, 3)) && (row == LETTER_HEIGHT - 1);
-        *(uint16_t *)dest = vga_to_rgb565(attrib >> ((((pgm_read_byte(&font[(int)let][row]) >> col) & 1) || underline) ? 0 : 4));
-        dest += 2;
+    PROF_BEGIN(lookup);
+
+    const uint16_t fore = vga_to_rgb565(attrib), back = vga_to_rgb565(attrib >> 4);
+
+    for (uint8_t row = 0; (row < LETTER_HEIGHT) && (dest_size > 0); ++row) {
+        uint8_t bits = font_row(let, row, BIT_EXT(attrib, 3));
+
+        for (uint8_t col = 0; (col < LETTER_WIDTH) && (dest_size > 0); ++col, dest_size -= 2) {
+            *(uint16_t *)dest = FONT_PIXEL(bits) ? fore : back;
+            bits = FONT_NEXT(bits);
+            dest += 2;
+        }
     }
+
+    PROF_END(lookup);
 }
 
 static void apply_output_entrys(void) {
     static uint8_t letter_buffer[LETTER_WIDTH * LETTER_HEIGHT * 2];
     struct Output_Entry entry;
-    
-    cli();
-    while (output_entry_stack_size > 0){
-        OUTPUT_ENTRY_POP(entry);
+    bool popped;
+
+    PROF_BEGIN(flush);
+    TRACE_EVENT(FLUSH_BEGIN, output_entry_stack_size);
+
+    /* Runs in task context only, so SPI transfers are not interrupted by other renderers */
+    for (;;){
+        OUTPUT_ENTRY_POP(entry, popped);
+        if (!popped)
+            break;
+
         v2 cur_pos = { entry.pos.x * LETTER_WIDTH, entry.pos.y * LETTER_HEIGHT };
 
         if ((strchr("\n\r\v\t\a\f", entry.data) != NULL) || (entry.data < ' '))
@@ -116,15 +151,16 @@ static void apply_output_entrys(void) {
     }
 
     critical_address = NULL;
-    sei();
+    TRACE_EVENT(FLUSH_END, 0);
+    PROF_END(flush);
 }
 
 static void update_flash_handles(bool flag) {
     struct Flash_Thread cur;
     const v2 old_cursor = cursor;
 
-    for (unsigned short i = 0; i < flash_thread_stack_size; ++i) {
-        cur = flash_thread_stack[i];
+    for (uint8_t i = pool_next(POOL_flash, 0); i != POOL_END; i = pool_next(POOL_flash, i + 1)) {
+        cur = *(struct Flash_Thread *)pool_block(POOL_flash, i);
         cursor = cur.pos;
         (cur.handle)(flag);
     }
@@ -133,29 +169,34 @@ static void update_flash_handles(bool flag) {
 }
 
 static void flash_thread_push(Flash_Routine routine) {
-    if (flash_thread_stack_size > FLASH_THREAD_STACK_CAP - 1)
+    struct Flash_Thread *thread = pool_alloc(POOL_flash);
+
+    if (!thread)
         return;
-    
-    flash_thread_stack[flash_thread_stack_size ++] = (struct Flash_Thread) {
+
+    *thread = (struct Flash_Thread) {
         .handle = routine,
         .pos = cursor
     };
 }
 
+static void flash_thread_clear(void) {
+    for (uint8_t i = pool_next(POOL_flash, 0); i != POOL_END; i = pool_next(POOL_flash, i + 1))
+        pool_free(POOL_flash, pool_block(POOL_flash, i));
+}
+
 static void refresh_screen(void) {
     cursor = (v2){ 0, 0 };
     disable_cursor();
-    ros_log(LOG_TYPE_INFO, "Press any key to refresh. . .");
-    sys_mode = SYSTEM_MODE_IDLE;
+    log_show(LOG_TYPE_INFO, "Press any key to refresh. . .");
     enable_cursor();
 
-    /* Wait for key */
-    while (idle_key == INVALID_KEY)
-        ;
+    /* video_task does not run while this waits, prompt is drawn here */
+    apply_output_entrys();
+    ros_pause();
 
     disable_cursor();
     clear_screen(0x0000);
-    idle_key = INVALID_KEY;
 }
 
 static v2 move_cursor_forward(void) {
@@ -176,9 +217,23 @@ static v2 move_cursor_forward(void) {
 
 void ros_flash(Flash_Routine routine) { flash_thread_push(routine); }
 
+/* Command output is copied to UART console, input line redraws & flash threads are not */
+static inline void mirror(unsigned char ch) {
+    if (sys_mode == SYSTEM_MODE_BUSY)
+        uart_mirror(ch);
+}
+
+void ros_mirror_puts(const char *str) {
+    while (*str)
+        mirror(UCHR(*str++));
+}
+
 #define IS_SEQ(c)   (strchr("\b\r\t\n", (char)(c)) != NULL)
 
 unsigned char ros_putchar(uint8_t attrib, const unsigned char ch) {
+    if (ch != UCHR('\t'))
+        mirror(ch);
+
     switch (ch) {
     case UCHR('\b'):
         if (!cursor.x && (cursor.y > 0)) {
@@ -232,6 +287,7 @@ int ros_puts(uint8_t attrib, const unsigned char *str, bool new_line) {
         
         oe.data = *str;
         printed ++;
+        mirror(*str);
         OUTPUT_ENTRY_PUSH(oe);
         oe.pos = move_cursor_forward();
     }
@@ -258,6 +314,7 @@ int ros_puts_P(uint8_t attrib, const unsigned char *str, bool new_line) {
         }
 
         oe.data = ch;
+        mirror(ch);
         OUTPUT_ENTRY_PUSH(oe);
 
         oe.pos = move_cursor_forward();
@@ -301,8 +358,162 @@ int ros_puts_R(const struct Running_String_Info * const info) {
     return printed;
 }
 
+/* Cells of one text row, drawn through a single window */
+struct Glyph_Span {
+    v2 pos;
+    uint8_t len;
+    unsigned char data[SCREEN_WIDTH / LETTER_WIDTH];
+    uint8_t attrib[SCREEN_WIDTH / LETTER_WIDTH];
+};
+
+/* Pixel rows go out across the whole span, no letter buffer is needed.
+   Scaled span repeats each pixel and each font row, cells are then scale x scale */
+static void span_flush(struct Glyph_Span *span, uint8_t scale) {
+    const uint8_t x = span->pos.x * LETTER_WIDTH, y = span->pos.y * LETTER_HEIGHT;
+
+    if (!span->len)
+        return;
+
+    st7735_set_window(x, y, x + span->len * LETTER_WIDTH * scale - 1, y + LETTER_HEIGHT * scale - 1);
+    BIT_ON(PORTB, ST7735_DC_PIN);
+
+    for (uint8_t row = 0; row < LETTER_HEIGHT; row++)
+    for (uint8_t line = 0; line < scale; line++)
+    for (uint8_t i = 0; i < span->len; i++) {
+        const uint8_t attrib = span->attrib[i];
+        const uint16_t fore = vga_to_rgb565(attrib), back = vga_to_rgb565(attrib >> 4);
+        uint8_t bits = font_row(span->data[i], row, BIT_EXT(attrib, 3) && (line == scale - 1));
+
+        for (uint8_t col = 0; col < LETTER_WIDTH; col++, bits = FONT_NEXT(bits)) {
+            const uint16_t pixel = FONT_PIXEL(bits) ? fore : back;
+
+            for (uint8_t dup = 0; dup < scale; dup++) {
+                spi_device_transfer_byte(LO8(pixel));
+                spi_device_transfer_byte(HI8(pixel));
+            }
+        }
+    }
+
+    BIT_OFF(PORTB, ST7735_DC_PIN);
+    span->len = 0;
+}
+
+static void span_put(struct Glyph_Span *span, uint8_t attrib, unsigned char ch) {
+    if (IS_SEQ(ch)) {
+        span_flush(span, 1);
+        ros_putchar(attrib, ch);
+        return;
+    }
+
+    if (!span->len)
+        span->pos = cursor;
+
+    span->data[span->len] = ch;
+    span->attrib[span->len ++] = attrib;
+    mirror(ch);
+
+    /* Wrapping may refresh the screen, so the row is drawn before it */
+    if (cursor.x + 1 >= SCREEN_WIDTH / LETTER_WIDTH)
+        span_flush(span, 1);
+
+    move_cursor_forward();
+}
+
+/* Run-length text from PROGMEM, see rle.h. Runs are not queued
+   as output entries: they are gathered into row spans and drawn directly */
+int ros_puts_rle_P(const uint8_t *stream, bool new_line) {
+    struct Glyph_Span span = { .len = 0 };
+    uint8_t attrib = ATTRIBUTE_DEFAULT, header;
+    int printed = 0;
+
+    /* Queued output goes first */
+    apply_output_entrys();
+
+    while ((header = pgm_read_byte(stream++)) != RLE_END) {
+        uint8_t count = header & ~RLE_RUN;
+
+        if (!header) {
+            attrib = pgm_read_byte(stream++);
+            continue;
+        }
+
+        printed += count;
+
+        if (header & RLE_RUN) {
+            const unsigned char ch = pgm_read_byte(stream++);
+            while (count --)
+                span_put(&span, attrib, ch);
+        } else
+            while (count --)
+                span_put(&span, attrib, pgm_read_byte(stream++));
+    }
+
+    span_flush(&span, 1);
+
+    if (!new_line)
+        return printed;
+
+    ros_putchar(attrib, '\n');
+    return ++printed;
+}
+
+/* Double size text: each character takes 2 x 2 cells of the grid, a run on one row
+   goes out through one window. Cursor is left after the last character, on its top row.
+   Rows that do not fit the screen are clipped */
+int ros_puts_2x(uint8_t attrib, const unsigned char *str, bool new_line) {
+    struct Glyph_Span span = { .pos = cursor, .len = 0 };
+    const uint8_t columns = SCREEN_WIDTH / LETTER_WIDTH, rows = SCREEN_HEIGHT / LETTER_HEIGHT + 1;
+    int printed = 0;
+
+    /* Queued output goes first */
+    apply_output_entrys();
+
+    for (; *str; str++) {
+        const bool wrap = (*str == UCHR('\n')) || (cursor.x + 2 > columns);
+
+        if (wrap) {
+            span_flush(&span, 2);
+            cursor.x = 0;
+            cursor.y += 2;
+        }
+
+        if (*str == UCHR('\n')) {
+            mirror('\n');
+            continue;
+        }
+
+        if (cursor.y + 2 > rows)
+            break;
+
+        if (!span.len)
+            span.pos = cursor;
+
+        span.data[span.len] = *str;
+        span.attrib[span.len ++] = attrib;
+        mirror(*str);
+
+        cursor.x += 2;
+        printed ++;
+    }
+
+    span_flush(&span, 2);
+
+    if (new_line) {
+        cursor.x = 0;
+        cursor.y += 2;
+        mirror('\n');
+    }
+
+    /* Normal output scrolls from the last row only */
+    if (cursor.y > rows - 1)
+        cursor.y = rows - 1;
+
+    return printed;
+}
+
 int ros_vprintf(uint8_t attrib, const char *format, va_list vptr) {
     static char output_buffer[21];
+    const unsigned short cap = sizeof(output_buffer) - 1;   /* Last byte is for '\0' */
     int printed;
     unsigned short buffer_pos;
 
@@ -310,7 +521,7 @@ int ros_vprintf(uint8_t attrib, const char *format, va_list vptr) {
     if (strchr(format, '%') == NULL)
         return ros_puts(attrib, USTR(format), false);
 
-    for (buffer_pos = 0, printed = 0; *format && buffer_pos < sizeof(output_buffer); format++){
+    for (buffer_pos = 0, printed = 0; *format && buffer_pos < cap; format++){
         bool seq = true;
 
         switch (*format) {
@@ -323,9 +534,8 @@ int ros_vprintf(uint8_t attrib, const char *format, va_list vptr) {
             break;
 
         case '\t':
-            output_buffer[buffer_pos] = output_buffer[buffer_pos + 1] = ' ';
-            buffer_pos += 2;
-            printed += 2;
+            for (uint8_t n = 0; (n < 2) && (buffer_pos < cap); n++, printed++)
+                output_buffer[buffer_pos++] = ' ';
             break;
 
         case '\n':
@@ -349,8 +559,12 @@ int ros_vprintf(uint8_t attrib, const char *format, va_list vptr) {
             continue;
         }
 
+        /* Format ending in '%' */
+        if (*++format == '\0')
+            break;
+
         unsigned short plen = 0;
-        switch (*++format) {
+        switch (*format) {
         case 'd': case 'D':
             plen = snprintf(output_buffer + buffer_pos, sizeof(output_buffer) - buffer_pos, "%d", va_arg(vptr, int));
             break;
@@ -376,6 +590,10 @@ int ros_vprintf(uint8_t attrib, const char *format, va_list vptr) {
             output_buffer[buffer_pos++] = *format;
         }
 
+        /* snprintf() reports untruncated length */
+        if (plen > cap - buffer_pos)
+            plen = cap - buffer_pos;
+
         buffer_pos += plen;
         printed += plen;
     }
@@ -393,23 +611,26 @@ int ros_printf(uint8_t attrib, const char *format, ...) {
     return ros_vprintf(attrib, format, vptr);
 }
 
+/* Flushes now: callers wait or draw directly, and video_task can't run until they return */
 void ros_apply_output_entrys(void) {
-    #ifndef NDEBUG
-        apply_output_entrys();
-    #endif
+    apply_output_entrys();
 }
 
 /* from ros.c */
 extern struct Input_Buffer ibuffer;
 
+static v2 input_cursor_at(unsigned short disp) {
+    return (v2){ ( cursor.x + disp ) % (SCREEN_WIDTH / LETTER_WIDTH), ( cursor.y + (disp + cursor.x) / (SCREEN_WIDTH / LETTER_WIDTH)) };
+}
+
 void ros_put_input_buffer(unsigned short disp, int overlap) {
     const v2 old_cursor = cursor;
-    const unsigned short odisp = disp;
+    const unsigned short len = INPUT_BUFFER_LENGTH(ibuffer);
 
-    while (disp --)
-        move_cursor_forward();
-    
-    ros_puts(ATTRIBUTE_DEFAULT, USTR(ibuffer.raw + odisp), false);
+    cursor = input_cursor_at(disp);
+
+    for (; disp < len; disp++)
+        ros_putchar(ATTRIBUTE_DEFAULT, INPUT_BUFFER_AT(ibuffer, disp));
 
     if (overlap > 0)
         while (overlap --)
@@ -418,22 +639,41 @@ void ros_put_input_buffer(unsigned short disp, int overlap) {
     cursor = old_cursor;
 }
 
+void ros_put_input_newline(void) {
+    cursor = input_cursor_at(INPUT_BUFFER_LENGTH(ibuffer));
+    ros_putchar(ATTRIBUTE_DEFAULT, '\n');
+}
+
+void ros_put_input_char(unsigned short disp) {
+    const v2 old_cursor = cursor;
+    const char ch = (disp < INPUT_BUFFER_LENGTH(ibuffer)) ? INPUT_BUFFER_AT(ibuffer, disp) : ' ';
+
+    cursor = input_cursor_at(disp);
+    ros_putchar(ATTRIBUTE_DEFAULT, ch);
+    cursor = old_cursor;
+}
+
 static void graphic_cursor_put(void) {
     v2 target = cursor;
 
     if (sys_mode == SYSTEM_MODE_INPUT)
-        target = (v2){ ( target.x + ibuffer.cursor ) % (SCREEN_WIDTH / LETTER_WIDTH), ( target.y + (ibuffer.cursor + target.x) / (SCREEN_WIDTH / LETTER_WIDTH)) };
+        target = input_cursor_at(ibuffer.gap_begin);
 
     v2 old_cursor = cursor;
     cursor = target;
-    ros_putchar((flash_time % 2) ? graphic_cursor.attrib_high : graphic_cursor.attrib_low, (sys_mode == SYSTEM_MODE_INPUT) ? (ibuffer.raw[ibuffer.cursor] ? ibuffer.raw[ibuffer.cursor] : ' ') : ' ');
+    ros_putchar((flash_time % 2) ? graphic_cursor.attrib_high : graphic_cursor.attrib_low, (sys_mode == SYSTEM_MODE_INPUT) ? (INPUT_BUFFER_UNDER(ibuffer) ? INPUT_BUFFER_UNDER(ibuffer) : ' ') : ' ');
     
     cursor = old_cursor;
 }
 
-void ros_put_prompt(void) { ros_puts(ATTRIBUTE_DEFAULT, USTR("$ "), false); }
+void ros_put_prompt(void) {
+    log_prompt();
+    ros_puts(ATTRIBUTE_DEFAULT, USTR("$ "), false);
+}
 
 void ros_graphic_timer_init(void) {
+    sched_spawn(video_task);
+
     cli();
     TCCR0A |= BIT(WGM01);       /* CTC timer mode */
     TCCR0B |= CS_BITS;          /* Prescaler */
@@ -443,7 +683,10 @@ void ros_graphic_timer_init(void) {
 }
 
 void clear_screen(uint16_t rgb565) {
-    output_entry_stack_size = flash_thread_stack_size = 0;
+    PROF_BEGIN(clear);
+
+    output_entry_stack_size = 0;
+    flash_thread_clear();
     cursor = (v2){ 0, 0 };
     st7735_set_window(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT);
 
@@ -454,9 +697,19 @@ void clear_screen(uint16_t rgb565) {
         spi_device_transfer_byte(LO8(rgb565));
     }
     BIT_OFF(PORTB, ST7735_DC_PIN);
+
+    PROF_END(clear);
 }
 
 
+/* Text cell, clamped to screen */
+void ros_move_cursor(uint8_t row, uint8_t col) {
+    cursor = (v2){
+        (col < SCREEN_WIDTH / LETTER_WIDTH) ? col : SCREEN_WIDTH / LETTER_WIDTH - 1,
+        (row <= SCREEN_HEIGHT / LETTER_HEIGHT) ? row : SCREEN_HEIGHT / LETTER_HEIGHT
+    };
+}
+
 void enable_cursor(void)
 {
     graphic_cursor.visible = true;
@@ -464,30 +717,46 @@ void enable_cursor(void)
 
 void disable_cursor(void)
 {
+    const v2 old_cursor = cursor;
     graphic_cursor.visible = false;
 
     if ((sys_mode != SYSTEM_MODE_INPUT) && (sys_mode != SYSTEM_MODE_IDLE))
         return;
 
     if (sys_mode == SYSTEM_MODE_INPUT)
-        for (unsigned short i = 0; i < ibuffer.cursor; i++)
-            move_cursor_forward();
+        cursor = input_cursor_at(ibuffer.gap_begin);
 
-    ros_putchar(ATTRIBUTE_DEFAULT, ibuffer.raw[ibuffer.cursor] ? ibuffer.raw[ibuffer.cursor] : ' ');
+    ros_putchar(ATTRIBUTE_DEFAULT, INPUT_BUFFER_UNDER(ibuffer) ? INPUT_BUFFER_UNDER(ibuffer) : ' ');
+    cursor = old_cursor;
 }
 
-ISR(TIMER0_COMPA_vect, ISR_NOBLOCK) {
-    /* Triggerred every 0.01 second */
-    flash_time += 1;
+/* Marquees, blinking cursor and other periodic screen work */
+static void __callback video_task(struct Task *self) {
+    TASK_BEGIN(self);
 
-    apply_output_entrys();
+    for (;;) {
+        if (flash_time % 3 == 0)
+            update_flash_handles(flash_time % 2);
 
-    if (flash_time % 3 == 0)
-        update_flash_handles(flash_time % 2);
+        if (graphic_cursor.visible)
+            graphic_cursor_put();
 
-    if (!(graphic_cursor.visible))
-        return;
+        apply_output_entrys();
+        TASK_WAIT_EVENT(self, SCHED_EVENT_TICK);
+    }
 
-    graphic_cursor_put();
-    apply_output_entrys();
+    TASK_END(self);
+}
+
+ISR(TIMER0_COMPA_vect) {
+    /* Triggerred every 0.01 second, rendering is done by video_task */
+    IRQ_MEASURE_BEGIN_TICK();
+    MEMSTAT_ISR_ENTER(MEMSTAT_ISR_TIMER0);
+    TRACE_EVENT(TIMER0_ENTER, 0);
+
+    flash_time += 1;
+    sched_tick();
+
+    TRACE_EVENT(TIMER0_EXIT, 0);
+    IRQ_MEASURE_END(IRQ_PROBE_TIMER0);
 }
\ No newline at end of file
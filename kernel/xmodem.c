@@ -0,0 +1,340 @@
+#include <inttypes.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "xmodem.h"
+#include "eeprom24.h"
+#include "bcache.h"
+#include "pool.h"
+#include "uart.h"
+#include "twi.h"
+#include "sched.h"
+#include "video.h"
+#include "shell.h"
+#include "log.h"
+#include "fs.h"
+#include "ros.h"
+
+/* One block receiving, one queued, one being written: ACK of block n waits for write of n - 1 */
+#define XMODEM_SLOTS            (XMODEM_WINDOW + 1)
+#define MS_TO_TICKS(ms)         (((ms) + SCHED_TICK_MS - 1) / SCHED_TICK_MS)
+
+/* receiver_frame() results besides sequence number, EOT & CAN come as negated bytes */
+#define FRAME_BAD               (-1)
+#define FRAME_TIMEOUT           (-2)
+
+static_assert( XMODEM_BLOCK_SIZE == FS_PAGE_SIZE );
+static_assert( XMODEM_BLOCK_SIZE <= POOL_BLOCK_SIZE(page) );
+
+/* Below enum FS_Error, so both fit one result */
+enum Xmodem_Error {
+    XMODEM_OK = 0,
+    XMODEM_ERROR_TIMEOUT = -16,
+    XMODEM_ERROR_CANCEL = -17,
+    XMODEM_ERROR_HEADER = -18,
+    XMODEM_ERROR_IO = -19,
+};
+
+struct Xmodem_Slot {
+    struct TWI_Transaction t;
+    uint8_t header[2];
+    uint8_t *data;
+    bool busy;
+};
+
+struct Xmodem_Receiver {
+    struct Xmodem_Slot slots[XMODEM_SLOTS];
+    struct FS_File file;
+    char name[XMODEM_NAME_CAP];
+    bool created;
+    uint16_t block;             /* Next expected data block, from 0 */
+    uint16_t naks;
+    int8_t ack_slot;            /* Accepted block waiting for previous write, -1 if none */
+    bool io_error;
+};
+
+static void slot_reap(struct Xmodem_Slot *s, bool *io_error) {
+    if (s->busy && (s->t.status != TWI_STATUS_PENDING)) {
+        s->busy = false;
+        if (s->t.status != TWI_STATUS_DONE)
+            *io_error = true;
+    }
+}
+
+/* Sends deferred ACK once page write of the block before it has finished */
+static void receiver_service(struct Xmodem_Receiver *r, bool wait) {
+    for (uint8_t i = 0; i < XMODEM_SLOTS; i++)
+        slot_reap(&r->slots[i], &r->io_error);
+
+    if (r->ack_slot < 0)
+        return;
+
+    struct Xmodem_Slot *prev = &r->slots[(r->ack_slot + XMODEM_SLOTS - 1) % XMODEM_SLOTS];
+
+    if (prev->busy && !wait)
+        return;
+
+    if (prev->busy) {
+        twi_wait(&prev->t);
+        slot_reap(prev, &r->io_error);
+    }
+
+    r->ack_slot = -1;
+    uart_putc(XMODEM_ACK);
+}
+
+/* Responses go out in frame order, so pending ACK is sent first */
+static void receiver_reply(struct Xmodem_Receiver *r, uint8_t c) {
+    receiver_service(r, true);
+    uart_putc(c);
+}
+
+static int receiver_getc(struct Xmodem_Receiver *r, uint16_t ms) {
+    const uint16_t begin = sched_now();
+    int c;
+
+    while ((c = uart_getc()) < 0) {
+        receiver_service(r, false);
+
+        if ((uint16_t)(sched_now() - begin) >= MS_TO_TICKS(ms))
+            return -1;
+    }
+
+    return c;
+}
+
+/* Drops the rest of a broken frame: waits until the line is silent */
+static void receiver_purge(struct Xmodem_Receiver *r) {
+    while (receiver_getc(r, XMODEM_BYTE_MS) >= 0)
+        ;
+}
+
+/* Returns frame sequence number or one of FRAME_* */
+static int receiver_frame(struct Xmodem_Receiver *r, uint8_t *data, uint16_t first_ms) {
+    uint8_t seq, nseq;
+    uint16_t crc = 0;
+    int c;
+
+    if ((c = receiver_getc(r, first_ms)) < 0)
+        return FRAME_TIMEOUT;
+
+    /* Single control byte is only trusted when the line goes silent after it */
+    if ((c == XMODEM_EOT) || (c == XMODEM_CAN))
+        return (receiver_getc(r, XMODEM_BYTE_MS) < 0) ? -c : FRAME_BAD;
+
+    if (c != XMODEM_SOH)
+        return FRAME_BAD;
+
+    if ((c = receiver_getc(r, XMODEM_BYTE_MS)) < 0)
+        return FRAME_BAD;
+    seq = (uint8_t)c;
+
+    if ((c = receiver_getc(r, XMODEM_BYTE_MS)) < 0)
+        return FRAME_BAD;
+    nseq = (uint8_t)c;
+
+    for (uint8_t i = 0; i < XMODEM_BLOCK_SIZE; i++) {
+        if ((c = receiver_getc(r, XMODEM_BYTE_MS)) < 0)
+            return FRAME_BAD;
+
+        data[i] = (uint8_t)c;
+        crc = xmodem_crc_update(crc, (uint8_t)c);
+    }
+
+    for (uint8_t i = 0; i < 2; i++) {
+        if ((c = receiver_getc(r, XMODEM_BYTE_MS)) < 0)
+            return FRAME_BAD;
+        crc ^= (uint16_t)c << (i ? 0 : 8);
+    }
+
+    return (crc || ((seq ^ nseq) != 0xFF)) ? FRAME_BAD : seq;
+}
+
+/* Existing file of the same name is replaced */
+static int receiver_header(struct Xmodem_Receiver *r, const uint8_t *data) {
+    uint16_t size;
+    int err;
+
+    memcpy(r->name, data, sizeof(r->name));
+    if (memchr(r->name, '\0', sizeof(r->name)) == NULL)
+        return XMODEM_ERROR_HEADER;
+
+    memcpy(&size, data + strlen(r->name) + 1, sizeof(size));
+
+    if (fs_open(r->name, &r->file) == FS_OK)
+        fs_remove(r->name);
+
+    if ((err = fs_create(r->name, size, &r->file)) < 0)
+        return err;
+    r->created = true;
+
+    /* Metadata goes out now, data pages bypass the cache, so no line may shadow them */
+    bcache_trim();
+    return XMODEM_OK;
+}
+
+static void receiver_write(struct Xmodem_Receiver *r, struct Xmodem_Slot *s) {
+    const uint16_t offset = r->block * XMODEM_BLOCK_SIZE;
+    const uint16_t addr = fs_address(&r->file, offset);
+
+    /* Sender pads last block */
+    if (offset >= r->file.entry.size)
+        return;
+
+    s->header[0] = (uint8_t)(addr >> 8);
+    s->header[1] = (uint8_t)addr;
+    s->t = (struct TWI_Transaction){
+        .address = EEPROM24_ADDRESS,
+        .flags = TWI_FLAG_ACK_POLL,
+        .header = s->header, .header_len = 2,
+        .tx = s->data,
+        .tx_len = (r->file.entry.size - offset < XMODEM_BLOCK_SIZE) ? r->file.entry.size - offset : XMODEM_BLOCK_SIZE
+    };
+
+    while (!twi_submit(&s->t))
+        receiver_service(r, false);
+    s->busy = true;
+}
+
+static int receiver_run(struct Xmodem_Receiver *r) {
+    uint8_t tries = 0;
+    int seq, err;
+
+    /* Header, receiver polls with 'C' like XMODEM-CRC */
+    for (;;) {
+        uart_putc(XMODEM_READY);
+
+        if ((seq = receiver_frame(r, r->slots[0].data, XMODEM_READY_MS)) == 0)
+            break;
+
+        if (seq == -XMODEM_CAN)
+            return XMODEM_ERROR_CANCEL;
+
+        if (seq == FRAME_BAD)
+            receiver_purge(r);
+
+        if (++tries >= XMODEM_RETRIES)
+            return XMODEM_ERROR_TIMEOUT;
+    }
+
+    if ((err = receiver_header(r, r->slots[0].data)) < 0) {
+        uart_putc(XMODEM_CAN);
+        return err;
+    }
+    uart_putc(XMODEM_ACK);
+
+    /* Data, sender keeps XMODEM_WINDOW frames in flight */
+    for (tries = 0;;) {
+        struct Xmodem_Slot *s = &r->slots[r->block % XMODEM_SLOTS];
+        const uint8_t expected = (uint8_t)(r->block + 1);
+
+        if (s->busy)
+            twi_wait(&s->t);
+        receiver_service(r, false);
+
+        seq = receiver_frame(r, s->data, XMODEM_READY_MS);
+
+        if ((seq == -XMODEM_EOT) && ((uint32_t)r->block * XMODEM_BLOCK_SIZE >= r->file.entry.size))
+            break;
+
+        if (seq == -XMODEM_CAN)
+            return XMODEM_ERROR_CANCEL;
+
+        if (seq == expected) {
+            receiver_write(r, s);
+            r->ack_slot = (int8_t)(r->block % XMODEM_SLOTS);
+            r->block ++;
+            tries = 0;
+            continue;
+        }
+
+        /* Our ACK was lost and sender went back */
+        if (seq == (uint8_t)(expected - 1)) {
+            receiver_reply(r, XMODEM_ACK);
+            continue;
+        }
+
+        if (++tries >= XMODEM_RETRIES) {
+            receiver_reply(r, XMODEM_CAN);
+            return XMODEM_ERROR_TIMEOUT;
+        }
+
+        if (seq == FRAME_BAD)
+            receiver_purge(r);
+
+        r->naks ++;
+        receiver_reply(r, XMODEM_NAK);
+    }
+
+    for (uint8_t i = 0; i < XMODEM_SLOTS; i++)
+        if (r->slots[i].busy)
+            twi_wait(&r->slots[i].t);
+    receiver_service(r, true);
+
+    if (r->io_error) {
+        uart_putc(XMODEM_CAN);
+        return XMODEM_ERROR_IO;
+    }
+
+    uart_putc(XMODEM_ACK);
+    return XMODEM_OK;
+}
+
+static const char *xmodem_strerror(int err) {
+    switch (err) {
+    case XMODEM_ERROR_TIMEOUT: return "Timeout";
+    case XMODEM_ERROR_CANCEL:  return "Cancelled";
+    case XMODEM_ERROR_HEADER:  return "Bad header";
+    case XMODEM_ERROR_IO:      return "I/O error";
+    case FS_ERROR_NAME:        return "Bad name";
+    case FS_ERROR_DIR_FULL:    return "Dir full";
+    case FS_ERROR_NO_SPACE:    return "No space";
+    case FS_ERROR_BAD_FS:      return "No filesystem";
+    default:                   return "Error";
+    }
+}
+
+/* Start 'tools/rexsend' on host, it types this command itself unless told not to */
+int shell_cmd_load(uint8_t argc, char **argv) {
+    struct Xmodem_Receiver r = { .ack_slot = -1 };
+    const bool mirror = uart_mirror_enabled;
+    const uint16_t begin = sched_now();
+    int err = XMODEM_ERROR_IO;
+    uint8_t n;
+
+    (void) argc;
+    (void) argv;
+
+    /* Page buffers are borrowed from cache lines */
+    bcache_trim();
+    for (n = 0; n < XMODEM_SLOTS; n++) {
+        if (!(r.slots[n].data = pool_alloc(POOL_page))) {
+            pool_reclaim(POOL_page);
+            if (!(r.slots[n].data = pool_alloc(POOL_page)))
+                break;
+        }
+    }
+
+    /* Console output would corrupt the protocol */
+    uart_mirror_enabled = false;
+    if (n == XMODEM_SLOTS)
+        err = receiver_run(&r);
+    uart_mirror_enabled = mirror;
+
+    while (n --)
+        pool_free(POOL_page, r.slots[n].data);
+
+    /* Partial file is not left behind */
+    if ((err < 0) && r.created && (fs_remove(r.name) == FS_OK))
+        bcache_flush();
+
+    if (err < 0) {
+        ros_log(LOG_TYPE_ERROR, "%s", xmodem_strerror(err));
+        return err;
+    }
+
+    ros_printf(ATTRIBUTE_DEFAULT, "%d bytes\n", (int)r.file.entry.size);
+    ros_printf(ATTRIBUTE_DEFAULT, "%d ms\n", (int)((uint16_t)(sched_now() - begin) * SCHED_TICK_MS));
+    ros_printf(ATTRIBUTE_DEFAULT, "%d retries\n", (int)r.naks);
+    return 0;
+}
@@ -0,0 +1,160 @@
+#include <inttypes.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "spiram.h"
+#include "xram.h"
+#include "video.h"
+#include "shell.h"
+#include "ros.h"
+
+static struct Xram_Block blocks[XRAM_HANDLES_CAP] = { 0 };
+static uint8_t order[XRAM_HANDLES_CAP] = { 0 };     /* Live handles, sorted by address */
+static uint8_t live = 0;
+static uint32_t capacity = 0, used = 0;
+
+void xram_init(uint32_t size) {
+    memset(blocks, 0, sizeof(blocks));
+    live = 0;
+    used = 0;
+    capacity = size;
+}
+
+static inline uint32_t block_end(uint8_t h) {
+    return (uint32_t)blocks[h].addr + blocks[h].size;
+}
+
+/* First fit: returns position in order[] and address of the gap */
+static bool find_gap(uint16_t size, uint8_t *pos, uint16_t *addr) {
+    uint32_t start = 0;
+
+    for (uint8_t i = 0; i <= live; i++) {
+        const uint32_t end = (i < live) ? blocks[order[i]].addr : capacity;
+
+        if (end - start >= size) {
+            *pos = i;
+            *addr = (uint16_t)start;
+            return true;
+        }
+
+        if (i < live)
+            start = block_end(order[i]);
+    }
+
+    return false;
+}
+
+static void block_move(uint8_t h, uint16_t dst) {
+    uint8_t buf[XRAM_MOVE_CHUNK];
+    const uint16_t src = blocks[h].addr;
+
+    /* Blocks only move down, so forward copy never overwrites unread data */
+    for (uint16_t off = 0; off < blocks[h].size; off += XRAM_MOVE_CHUNK) {
+        const uint16_t n = (blocks[h].size - off < XRAM_MOVE_CHUNK) ? blocks[h].size - off : XRAM_MOVE_CHUNK;
+
+        spiram_read(src + off, buf, n);
+        spiram_write(dst + off, buf, n);
+    }
+
+    blocks[h].addr = dst;
+}
+
+/* Slides all blocks to the bottom, leaving a single free gap on top */
+static void xram_compact(void) {
+    uint16_t dst = 0;
+
+    for (uint8_t i = 0; i < live; i++) {
+        const uint8_t h = order[i];
+
+        if (blocks[h].addr != dst)
+            block_move(h, dst);
+
+        dst += blocks[h].size;
+    }
+}
+
+Xram_Handle xram_alloc(uint16_t size) {
+    uint8_t h = 0, pos;
+    uint16_t addr;
+
+    if (!size || (size > capacity - used))
+        return XRAM_NULL;
+
+    while ((h < XRAM_HANDLES_CAP) && blocks[h].size)
+        h++;
+
+    if (h == XRAM_HANDLES_CAP)
+        return XRAM_NULL;
+
+    if (!find_gap(size, &pos, &addr)) {
+        xram_compact();
+        if (!find_gap(size, &pos, &addr))
+            return XRAM_NULL;
+    }
+
+    memmove(&order[pos + 1], &order[pos], live - pos);
+    order[pos] = h;
+    live ++;
+
+    blocks[h] = (struct Xram_Block){ .addr = addr, .size = size };
+    used += size;
+    return h;
+}
+
+void xram_free(Xram_Handle h) {
+    uint8_t pos = 0;
+
+    if ((h >= XRAM_HANDLES_CAP) || !blocks[h].size)
+        return;
+
+    while (order[pos] != h)
+        pos++;
+
+    memmove(&order[pos], &order[pos + 1], live - pos - 1);
+    live --;
+
+    used -= blocks[h].size;
+    blocks[h].size = 0;
+}
+
+uint16_t xram_size(Xram_Handle h) {
+    return (h < XRAM_HANDLES_CAP) ? blocks[h].size : 0;
+}
+
+uint32_t xram_available(void) {
+    return capacity - used;
+}
+
+static bool xram_range(Xram_Handle h, uint16_t offset, uint16_t len) {
+    return (h < XRAM_HANDLES_CAP) && ((uint32_t)offset + len <= blocks[h].size);
+}
+
+int xram_read(Xram_Handle h, uint16_t offset, void *buf, uint16_t len) {
+    if (!xram_range(h, offset, len))
+        return -1;
+
+    spiram_read(blocks[h].addr + offset, buf, len);
+    return len;
+}
+
+int xram_write(Xram_Handle h, uint16_t offset, const void *buf, uint16_t len) {
+    if (!xram_range(h, offset, len))
+        return -1;
+
+    spiram_write(blocks[h].addr + offset, buf, len);
+    return len;
+}
+
+int shell_cmd_xram(uint8_t argc, char **argv) {
+    (void) argc;
+    (void) argv;
+
+    /* ros_printf has no long format, sizes are shown in 256-byte units */
+    ros_printf(ATTRIBUTE_DEFAULT, "Used\t%d / %d\n", (int)(used >> 8), (int)(capacity >> 8));
+    ros_printf(ATTRIBUTE_DEFAULT, "Handles\t%d\n", live);
+
+    for (uint8_t i = 0; i < live; i++)
+        ros_printf(ATTRIBUTE_DEFAULT, "%d\t%x +%x\n", order[i], blocks[order[i]].addr, blocks[order[i]].size);
+
+    return 0;
+}
@@ -0,0 +1,14 @@
+#ifndef _AVRSIM_INTERRUPT_H
+#define _AVRSIM_INTERRUPT_H
+
+/* Interrupts are the bus thread of tools/twi_sim.c, masking them takes its lock */
+void twi_sim_irq_lock(void);
+void twi_sim_irq_unlock(void);
+
+#define ISR(vector)     void vector(void)
+#define TWI_vect        twi_sim_vect
+
+#define cli()           twi_sim_irq_lock()
+#define sei()           twi_sim_irq_unlock()
+
+#endif /* _AVRSIM_INTERRUPT_H */
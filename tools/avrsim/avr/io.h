@@ -0,0 +1,21 @@
+#ifndef _AVRSIM_IO_H
+#define _AVRSIM_IO_H
+
+#include <inttypes.h>
+
+/* Host stand-in for the registers drivers/twi.c touches, tools/twi_sim.c plays the hardware */
+#define _BV(bit)        (1U << (bit))
+
+extern volatile uint8_t TWBR, TWSR, TWDR, TWCR;
+extern volatile uint8_t PORTC, DDRC;
+extern volatile uint16_t SP;
+
+#define TWIE            0
+#define TWEN            2
+#define TWWC            3
+#define TWSTO           4
+#define TWSTA           5
+#define TWEA            6
+#define TWINT           7
+
+#endif /* _AVRSIM_IO_H */
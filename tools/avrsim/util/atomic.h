@@ -0,0 +1,10 @@
+#ifndef _AVRSIM_ATOMIC_H
+#define _AVRSIM_ATOMIC_H
+
+#include <avr/interrupt.h>
+
+#define ATOMIC_RESTORESTATE
+#define ATOMIC_BLOCK(type)                                                  \
+    for (int _atomic = (twi_sim_irq_lock(), 1); _atomic; _atomic = (twi_sim_irq_unlock(), 0))
+
+#endif /* _AVRSIM_ATOMIC_H */
@@ -0,0 +1,164 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "fs.h"
+#include "twi.h"
+#include "eeprom24.h"
+#include "bcache.h"
+#include "twi_sim.h"
+
+#define CHUNK   32              /* Same as cat */
+#define PIECE   10              /* Small appends, one EEPROM page takes several */
+
+/* Runs a file through fs -> eeprom24 -> simulated TWI bus and reports bus time */
+
+static int chunked_read(const struct FS_Device *dev, const char *name, uint8_t *dest) {
+    struct FS_File file;
+    uint16_t offset = 0;
+    int len;
+
+    if ((fs_mount(dev) != FS_OK) || (fs_open(name, &file) != FS_OK))
+        return -1;
+
+    while ((len = fs_read(&file, offset, dest + offset, CHUNK)) > 0)
+        offset += (uint16_t)len;
+
+    return (len < 0) ? -1 : offset;
+}
+
+/* Rewrites the file in PIECE-byte writes, dirty pages go out on flush */
+static int pieced_write(const struct FS_Device *dev, const char *name, const uint8_t *src, uint16_t size) {
+    struct FS_File file;
+    uint16_t offset;
+
+    if ((fs_mount(dev) != FS_OK) || (fs_open(name, &file) != FS_OK))
+        return -1;
+
+    for (offset = 0; offset < size; offset += PIECE) {
+        const uint16_t len = (size - offset < PIECE) ? size - offset : PIECE;
+
+        if (fs_write(&file, offset, src + offset, len) != len)
+            return -1;
+    }
+
+    return (bcache_flush() < 0) ? -1 : size;
+}
+
+static void report(const char *what, const struct TWI_Sim_Stats *before, size_t size) {
+    const struct TWI_Sim_Stats *now = twi_sim_stats();
+
+    printf("%-8s %6zu bytes %9.2f ms %6lu transactions %6lu polls %5lu page writes\n", what, size,
+        (now->bus_us - before->bus_us) / 1000.0,
+        now->transactions - before->transactions,
+        now->polls - before->polls,
+        now->writes - before->writes);
+}
+
+int main(int argc, char **argv) {
+    struct TWI_Sim_Stats before;
+    struct FS_File file;
+    FILE *input;
+    uint8_t *data, *check;
+    long size;
+
+    if (argc != 3) {
+        fprintf(stderr, "Usage: %s <file> <name.ext>\n", argv[0]);
+        return 1;
+    }
+
+    if (!(input = fopen(argv[1], "rb"))) {
+        perror(argv[1]);
+        return 1;
+    }
+
+    fseek(input, 0, SEEK_END);
+    size = ftell(input);
+    rewind(input);
+
+    if ((size <= 0) || (size > 0xFFFF)) {
+        fprintf(stderr, "Bad file size: %ld\n", size);
+        return 1;
+    }
+
+    data = malloc((size_t)size);
+    check = malloc((size_t)size);
+    if (!data || !check || (fread(data, 1, (size_t)size, input) != (size_t)size)) {
+        fprintf(stderr, "Can't read %s\n", argv[1]);
+        return 1;
+    }
+    fclose(input);
+
+    twi_sim_reset();
+    twi_init();
+
+    before = *twi_sim_stats();
+    if (fs_format(&eeprom24_device) != FS_OK) {
+        fprintf(stderr, "Format failed\n");
+        return 1;
+    }
+    report("format", &before, 0);
+
+    before = *twi_sim_stats();
+    if ((fs_create(argv[2], (uint16_t)size, &file) != FS_OK) ||
+        (fs_write(&file, 0, data, (uint16_t)size) != size)) {
+        fprintf(stderr, "Write failed\n");
+        return 1;
+    }
+    report("write", &before, (size_t)size);
+
+    before = *twi_sim_stats();
+    if ((fs_open(argv[2], &file) != FS_OK) ||
+        (fs_read(&file, 0, check, (uint16_t)size) != size)) {
+        fprintf(stderr, "Read failed\n");
+        return 1;
+    }
+    report("read", &before, (size_t)size);
+
+    if (memcmp(data, check, (size_t)size)) {
+        fprintf(stderr, "Verify failed\n");
+        return 1;
+    }
+
+    before = *twi_sim_stats();
+    memset(check, 0, (size_t)size);
+    if ((chunked_read(&eeprom24_device, argv[2], check) != size) || memcmp(data, check, (size_t)size)) {
+        fprintf(stderr, "Chunked read failed\n");
+        return 1;
+    }
+    report("chunked", &before, (size_t)size);
+
+    bcache_init(&eeprom24_device);
+    before = *twi_sim_stats();
+    memset(check, 0, (size_t)size);
+    if ((chunked_read(&bcache_device, argv[2], check) != size) || memcmp(data, check, (size_t)size)) {
+        fprintf(stderr, "Cached read failed\n");
+        return 1;
+    }
+    report("cached", &before, (size_t)size);
+
+    for (long i = 0; i < size; i++)
+        check[i] = data[i] ^ 0x5A;
+
+    before = *twi_sim_stats();
+    if (pieced_write(&bcache_device, argv[2], check, (uint16_t)size) != size) {
+        fprintf(stderr, "Pieced write failed\n");
+        return 1;
+    }
+    report("pieces", &before, (size_t)size);
+
+    memset(data, 0, (size_t)size);
+    if ((chunked_read(&eeprom24_device, argv[2], data) != size) || memcmp(data, check, (size_t)size)) {
+        fprintf(stderr, "Pieced write verify failed\n");
+        return 1;
+    }
+
+    const struct Bcache_Stats *st = bcache_stats();
+    printf("cache    %u hits %u misses %u ahead %u bypass %u writebacks\n",
+        st->hits, st->misses, st->readahead, st->bypass, st->writebacks);
+
+    puts("Verify OK");
+    free(data);
+    free(check);
+    return 0;
+}
@@ -0,0 +1,155 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "fs.h"
+#include "ramdisk.h"
+
+/* Builds and inspects ROS filesystem images for external EEPROM */
+
+#define DEFAULT_IMAGE_SIZE      32768
+
+static void __attribute__((noreturn)) usage(const char *self) {
+    fprintf(stderr, "usage: %s -c <image> [-s <bytes>] <files...>  - create image\n"
+                    "       %s -l <image> [-s <bytes>]             - list image\n"
+                    "       %s -x <image> [-s <bytes>] <file>      - extract file to stdout\n",
+                    self, self, self);
+    exit(EXIT_FAILURE);
+}
+
+static const char *fs_error_str(int err) {
+    switch (err) {
+    case FS_ERROR_IO:        return "I/O error";
+    case FS_ERROR_NAME:      return "bad name ( 8.4, rex/raw/txt/rtm/rch8 )";
+    case FS_ERROR_EXISTS:    return "file exists";
+    case FS_ERROR_NOT_FOUND: return "not found";
+    case FS_ERROR_DIR_FULL:  return "directory full";
+    case FS_ERROR_NO_SPACE:  return "no space";
+    case FS_ERROR_BAD_FS:    return "not a ROS filesystem";
+    default:                 return "unknown error";
+    }
+}
+
+static void __attribute__((noreturn)) fail(const char *what, int err) {
+    fprintf(stderr, "%s: %s\n", what, fs_error_str(err));
+    ramdisk_destroy();
+    exit(EXIT_FAILURE);
+}
+
+static void add_file(const char *path) {
+    const char *name = strrchr(path, '/') ? strrchr(path, '/') + 1 : path;
+    struct FS_File file;
+    uint8_t *data;
+    long size;
+    int res;
+
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        perror(path);
+        exit(EXIT_FAILURE);
+    }
+
+    fseek(f, 0, SEEK_END);
+    size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+
+    if ((size > UINT16_MAX) || !(data = malloc(size ? size : 1))) {
+        fclose(f);
+        fail(path, FS_ERROR_NO_SPACE);
+    }
+
+    if (fread(data, 1, size, f) != (size_t)size) {
+        fclose(f);
+        free(data);
+        fail(path, FS_ERROR_IO);
+    }
+    fclose(f);
+
+    if (((res = fs_create(name, (uint16_t)size, &file)) < 0) || ((res = fs_write(&file, 0, data, (uint16_t)size)) < 0)) {
+        free(data);
+        fail(name, res);
+    }
+
+    printf("%-13s %5ld bytes at page %u\n", name, size, file.entry.start);
+    free(data);
+}
+
+static void list_files(void) {
+    const struct FS_Superblock *sb = fs_superblock();
+    struct FS_Entry entry;
+    uint8_t iter = 0;
+
+    while (fs_readdir(&iter, &entry) == FS_OK)
+        printf("%.8s.%.4s\t%5u bytes\tpages %u-%u\tslot %u\n", entry.name, entry.ext, entry.size,
+               entry.start, entry.start + (entry.size + FS_PAGE_SIZE - 1) / FS_PAGE_SIZE - (entry.size > 0), iter - 1);
+
+    printf("%u/%u pages free ( %u bytes each )\n", sb->free_pages, sb->pages, sb->page_size);
+}
+
+static void extract_file(const char *name) {
+    struct FS_File file;
+    uint8_t buf[FS_PAGE_SIZE];
+    int res;
+
+    if ((res = fs_open(name, &file)) < 0)
+        fail(name, res);
+
+    for (uint16_t off = 0; (res = fs_read(&file, off, buf, sizeof(buf))) > 0; off += res)
+        fwrite(buf, 1, res, stdout);
+}
+
+int main(int argc, char *argv[]) {
+    uint32_t size = DEFAULT_IMAGE_SIZE;
+    int i = 3, res;
+
+    if ((argc < 3) || (argv[1][0] != '-'))
+        usage(argv[0]);
+
+    if ((argc > 4) && !strcmp(argv[3], "-s")) {
+        size = strtoul(argv[4], NULL, 0);
+        i = 5;
+    }
+
+    const struct FS_Device *dev = ramdisk_create(size);
+    if (!dev) {
+        fprintf(stderr, "Out of memory.\n");
+        return EXIT_FAILURE;
+    }
+
+    switch (argv[1][1]) {
+    case 'c':
+        if ((res = fs_format(dev)) < 0)
+            fail(argv[2], res);
+
+        for (; i < argc; i++)
+            add_file(argv[i]);
+
+        list_files();
+        if (ramdisk_save(argv[2]) < 0)
+            fail(argv[2], FS_ERROR_IO);
+        break;
+
+    case 'l':
+    case 'x':
+        if (ramdisk_load(argv[2]) < 0)
+            fail(argv[2], FS_ERROR_IO);
+
+        if ((res = fs_mount(dev)) < 0)
+            fail(argv[2], res);
+
+        if (argv[1][1] == 'l')
+            list_files();
+        else if (i < argc)
+            extract_file(argv[i]);
+        else
+            usage(argv[0]);
+        break;
+
+    default:
+        usage(argv[0]);
+    }
+
+    ramdisk_destroy();
+    return 0;
+}
@@ -0,0 +1,71 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "ramdisk.h"
+
+static uint8_t *image = NULL;
+static uint32_t image_size = 0;
+static struct FS_Device device = { 0 };
+
+static int ramdisk_read(uint16_t addr, void *buf, uint16_t len) {
+    if ((uint32_t)addr + len > image_size)
+        return -1;
+
+    memcpy(buf, image + addr, len);
+    return len;
+}
+
+static int ramdisk_write(uint16_t addr, const void *buf, uint16_t len) {
+    if ((uint32_t)addr + len > image_size)
+        return -1;
+
+    memcpy(image + addr, buf, len);
+    return len;
+}
+
+const struct FS_Device *ramdisk_create(uint32_t size) {
+    ramdisk_destroy();
+
+    /* Erased EEPROM reads as 0xFF */
+    if ((image = malloc(size)) == NULL)
+        return NULL;
+    memset(image, 0xFF, size);
+
+    image_size = size;
+    device = (struct FS_Device){
+        .read = ramdisk_read,
+        .write = ramdisk_write,
+        .pages = (uint16_t)(size / FS_PAGE_SIZE)
+    };
+    return &device;
+}
+
+void ramdisk_destroy(void) {
+    free(image);
+    image = NULL;
+    image_size = 0;
+}
+
+int ramdisk_load(const char *path) {
+    FILE *f = fopen(path, "rb");
+
+    if (!f)
+        return -1;
+
+    size_t n = fread(image, 1, image_size, f);
+    fclose(f);
+    return (int)n;
+}
+
+int ramdisk_save(const char *path) {
+    FILE *f = fopen(path, "wb");
+
+    if (!f)
+        return -1;
+
+    size_t n = fwrite(image, 1, image_size, f);
+    fclose(f);
+    return (n == image_size) ? 0 : -1;
+}
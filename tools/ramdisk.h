@@ -0,0 +1,15 @@
+#ifndef _RAMDISK_H
+#define _RAMDISK_H
+
+#include <inttypes.h>
+
+#include "fs.h"
+
+/* RAM-backed stand-in for external EEPROM chip */
+const struct FS_Device *ramdisk_create(uint32_t size);
+void ramdisk_destroy(void);
+
+int ramdisk_load(const char *path);
+int ramdisk_save(const char *path);
+
+#endif /* _RAMDISK_H */
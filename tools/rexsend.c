@@ -0,0 +1,264 @@
+/* getopt, select & friends under -std=c11 */
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/time.h>
+#include <sys/select.h>
+#include <sys/ioctl.h>
+
+#ifdef __linux__
+    #include <asm/termbits.h>
+#endif
+
+#include "xmodem.h"
+
+/* Uploads a file into ROS filesystem over UART console ( 'load' command ), POSIX only */
+
+#define DEFAULT_BAUD        250000
+#define READY_TIMEOUT_MS    5000
+#define REPLY_TIMEOUT_MS    2000    /* Covers EEPROM write cycles behind the window */
+#define PURGE_MS            200
+
+static int port = -1;
+
+static void __attribute__((noreturn)) usage(const char *self) {
+    fprintf(stderr, "usage: %s [-b <baud>] [-n <NAME.EXT>] [-s] <port> <file>\n"
+                    "       -s  do not type 'load', receiver is already waiting\n", self);
+    exit(EXIT_FAILURE);
+}
+
+static void __attribute__((noreturn)) fail(const char *what) {
+    fprintf(stderr, "%s\n", what);
+    exit(EXIT_FAILURE);
+}
+
+static double now_ms(void) {
+    struct timeval tv;
+
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec * 1000.0 + tv.tv_usec / 1000.0;
+}
+
+/* Raw 8N1, any baud on Linux. Elsewhere ( pty of simulator, pre-configured tty ) it is left as is */
+static void port_setup(int baud) {
+#ifdef __linux__
+    struct termios2 tio;
+
+    if (ioctl(port, TCGETS2, &tio) < 0)
+        return;
+
+    tio.c_iflag = 0;
+    tio.c_oflag = 0;
+    tio.c_lflag = 0;
+    tio.c_cflag = CS8 | CREAD | CLOCAL | BOTHER;
+    tio.c_ispeed = tio.c_ospeed = (speed_t)baud;
+    tio.c_cc[VMIN] = 0;
+    tio.c_cc[VTIME] = 0;
+
+    if (ioctl(port, TCSETS2, &tio) < 0)
+        perror("TCSETS2");
+#else
+    (void) baud;
+#endif
+}
+
+static void port_write(const void *buf, size_t len) {
+    const uint8_t *p = buf;
+
+    while (len > 0) {
+        const ssize_t n = write(port, p, len);
+
+        if ((n < 0) && (errno != EINTR) && (errno != EAGAIN))
+            fail("port write failed");
+
+        if (n > 0) {
+            p += n;
+            len -= (size_t)n;
+        }
+    }
+}
+
+/* -1 on timeout */
+static int port_getc(int ms) {
+    struct timeval tv = { ms / 1000, (ms % 1000) * 1000 };
+    fd_set set;
+    uint8_t c;
+
+    FD_ZERO(&set);
+    FD_SET(port, &set);
+
+    if (select(port + 1, &set, NULL, NULL, &tv) <= 0)
+        return -1;
+
+    return (read(port, &c, 1) == 1) ? c : -1;
+}
+
+static void port_purge(void) {
+    while (port_getc(PURGE_MS) >= 0)
+        ;
+}
+
+static void send_frame(uint8_t seq, const uint8_t *block) {
+    uint8_t frame[XMODEM_FRAME_SIZE];
+    uint16_t crc = 0;
+
+    frame[0] = XMODEM_SOH;
+    frame[1] = seq;
+    frame[2] = (uint8_t)~seq;
+    memcpy(frame + 3, block, XMODEM_BLOCK_SIZE);
+
+    for (int i = 0; i < XMODEM_BLOCK_SIZE; i++)
+        crc = xmodem_crc_update(crc, block[i]);
+
+    frame[3 + XMODEM_BLOCK_SIZE] = (uint8_t)(crc >> 8);
+    frame[4 + XMODEM_BLOCK_SIZE] = (uint8_t)crc;
+    port_write(frame, sizeof(frame));
+}
+
+/* Single frame in flight: header and EOT */
+static void send_acked(const uint8_t *block, uint8_t seq, int timeout_ms) {
+    for (int tries = 0; tries < XMODEM_RETRIES; tries++) {
+        int c;
+
+        if (block)
+            send_frame(seq, block);
+        else
+            port_write((const uint8_t []){ XMODEM_EOT }, 1);
+
+        /* Repeated 'C' means header was not received, same as NAK */
+        if ((c = port_getc(timeout_ms)) == XMODEM_ACK)
+            return;
+
+        if (c == XMODEM_CAN)
+            fail("receiver cancelled");
+    }
+
+    fail("no reply");
+}
+
+/* Go-back-N: on NAK or silence, every frame from the oldest unacknowledged one is sent again */
+static unsigned send_data(const uint8_t *data, size_t size) {
+    const size_t blocks = (size + XMODEM_BLOCK_SIZE - 1) / XMODEM_BLOCK_SIZE;
+    size_t base = 0, next = 0;
+    unsigned retries = 0;
+    uint8_t block[XMODEM_BLOCK_SIZE];
+
+    while (base < blocks) {
+        while ((next < blocks) && (next - base < XMODEM_WINDOW)) {
+            const size_t off = next * XMODEM_BLOCK_SIZE;
+            const size_t len = (size - off < XMODEM_BLOCK_SIZE) ? size - off : XMODEM_BLOCK_SIZE;
+
+            memset(block, 0x1A, sizeof(block));
+            memcpy(block, data + off, len);
+            send_frame((uint8_t)(next + 1), block);
+            next ++;
+        }
+
+        const int c = port_getc(REPLY_TIMEOUT_MS);
+
+        if (c == XMODEM_ACK) {
+            base ++;
+            fprintf(stderr, "\r%zu / %zu", base, blocks);
+            continue;
+        }
+
+        if (c == XMODEM_CAN)
+            fail("\nreceiver cancelled");
+
+        if (++retries > XMODEM_RETRIES * blocks)
+            fail("\ntoo many retries");
+
+        /* Frames behind the failed one are refused too, their replies are dropped */
+        port_purge();
+        next = base;
+    }
+
+    fputc('\n', stderr);
+    return retries;
+}
+
+int main(int argc, char **argv) {
+    const char *name = NULL;
+    bool typed = true;
+    int baud = DEFAULT_BAUD;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "b:n:s")) != -1) {
+        switch (opt) {
+        case 'b': baud = atoi(optarg); break;
+        case 'n': name = optarg; break;
+        case 's': typed = false; break;
+        default:  usage(argv[0]);
+        }
+    }
+
+    if (argc - optind != 2)
+        usage(argv[0]);
+
+    const char *path = argv[optind + 1];
+    if (!name)
+        name = strrchr(path, '/') ? strrchr(path, '/') + 1 : path;
+
+    if (strlen(name) >= XMODEM_NAME_CAP)
+        fail("name too long ( 8.4 )");
+
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        perror(path);
+        return EXIT_FAILURE;
+    }
+
+    static uint8_t data[UINT16_MAX];
+    const size_t size = fread(data, 1, sizeof(data), f);
+    fclose(f);
+
+    if (size == sizeof(data))
+        fail("file too large");
+
+    if ((port = open(argv[optind], O_RDWR | O_NOCTTY)) < 0) {
+        perror(argv[optind]);
+        return EXIT_FAILURE;
+    }
+    port_setup(baud);
+
+    if (typed)
+        port_write("load\r", 5);
+
+    /* Console echo comes first, receiver is ready on 'C' */
+    const double begin = now_ms();
+    int c;
+    while ((c = port_getc(READY_TIMEOUT_MS)) != XMODEM_READY)
+        if ((c < 0) || (now_ms() - begin > READY_TIMEOUT_MS))
+            fail("receiver not ready");
+
+    uint8_t header[XMODEM_BLOCK_SIZE] = { 0 };
+    const uint16_t size16 = (uint16_t)size;
+
+    memcpy(header, name, strlen(name));
+    header[strlen(name) + 1] = (uint8_t)size16;
+    header[strlen(name) + 2] = (uint8_t)(size16 >> 8);
+    send_acked(header, 0, REPLY_TIMEOUT_MS);
+
+    /* Header sent twice ( it crossed with a late 'C' ) is acknowledged twice */
+    port_purge();
+
+    const double start = now_ms();
+    const unsigned retries = send_data(data, size);
+    send_acked(NULL, 0, REPLY_TIMEOUT_MS);
+
+    const double ms = now_ms() - start;
+    const double line_ms = (double)((size + XMODEM_BLOCK_SIZE - 1) / XMODEM_BLOCK_SIZE) * XMODEM_FRAME_SIZE * 10000.0 / baud;
+
+    fprintf(stderr, "%s: %zu bytes in %.0f ms ( %.0f B/s, line rate %.0f ms ), %u retries\n",
+            name, size, ms, size * 1000.0 / ms, line_ms, retries);
+
+    close(port);
+    return EXIT_SUCCESS;
+}
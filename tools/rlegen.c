@@ -0,0 +1,73 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+
+#include "rle.h"
+
+/* Turns a text screen ( raw character codes, rows wrap at screen width ) into
+   ros_puts_rle_P() stream initializer, format is in rle.h */
+
+#define RUN_MIN             3       /* Shorter runs cost less as characters */
+#define SCREEN_CAP          4096
+
+static size_t emitted = 0;
+
+static void emit(const char *format, unsigned value) {
+    printf(format, value);
+    emitted ++;
+}
+
+static size_t run_length(const uint8_t *data, size_t size, size_t pos) {
+    size_t len = 1;
+
+    while ((pos + len < size) && (len < RLE_COUNT_MAX) && (data[pos + len] == data[pos]))
+        len ++;
+
+    return len;
+}
+
+int main(int argc, char **argv) {
+    static uint8_t data[SCREEN_CAP];
+
+    if (argc != 2) {
+        fprintf(stderr, "usage: %s <screen>\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    FILE *f = fopen(argv[1], "rb");
+    if (!f) {
+        perror(argv[1]);
+        return EXIT_FAILURE;
+    }
+
+    const size_t size = fread(data, 1, sizeof(data), f);
+    fclose(f);
+
+    for (size_t pos = 0; pos < size;) {
+        size_t len = run_length(data, size, pos);
+
+        if (len >= RUN_MIN) {
+            emit("    RLE_RUN | %u,", (unsigned)len);
+            emit(" 0x%02x,\n", data[pos]);
+            pos += len;
+            continue;
+        }
+
+        /* Characters up to the next run worth encoding */
+        for (len = 0; (pos + len < size) && (len < RLE_COUNT_MAX) && (run_length(data, size, pos + len) < RUN_MIN); )
+            len += run_length(data, size, pos + len);
+
+        if (len > RLE_COUNT_MAX)
+            len = RLE_COUNT_MAX;
+
+        emit("    %u,", (unsigned)len);
+        for (size_t i = 0; i < len; i++)
+            emit(" 0x%02x,", data[pos + i]);
+        putchar('\n');
+        pos += len;
+    }
+
+    emit("    RLE_END\n", 0);
+    fprintf(stderr, "%zu -> %zu bytes\n", size, emitted);
+    return EXIT_SUCCESS;
+}
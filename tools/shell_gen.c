@@ -0,0 +1,130 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+#include "shell_hash.h"
+
+/* Builds PROGMEM command registry from include/commands.def */
+/* Minimal perfect hash: bucket = h(name, 0) % B, slot = h(name, displace[bucket]) % N */
+
+struct Command_Info {
+    const char *name;
+    const char *min, *max;
+    const char *help;
+    int bucket, slot;
+};
+
+#define CMD(name, min, max, help)   { #name, #min, #max, help, 0, -1 },
+static struct Command_Info commands[] = {
+    #include "commands.def"
+};
+#undef CMD
+
+#define COMMANDS_NUMBER     (int)(sizeof(commands) / sizeof(commands[0]))
+#define BUCKETS_NUMBER      ((COMMANDS_NUMBER + 1) / 2)
+
+static uint8_t displace[BUCKETS_NUMBER];
+static int slots[COMMANDS_NUMBER];
+
+static int bucket_size(int bucket) {
+    int n = 0;
+    for (int i = 0; i < COMMANDS_NUMBER; i++)
+        n += (commands[i].bucket == bucket);
+    return n;
+}
+
+static int try_displace(int bucket, uint8_t d) {
+    int taken[COMMANDS_NUMBER], ntaken = 0;
+
+    for (int i = 0; i < COMMANDS_NUMBER; i++) {
+        if (commands[i].bucket != bucket)
+            continue;
+
+        int slot = shell_hash(commands[i].name, strlen(commands[i].name), d) % COMMANDS_NUMBER;
+        if (slots[slot] >= 0)
+            return 0;
+
+        for (int j = 0; j < ntaken; j++)
+            if (taken[j] == slot)
+                return 0;
+
+        taken[ntaken++] = slot;
+    }
+
+    for (int i = 0, j = 0; i < COMMANDS_NUMBER; i++)
+        if (commands[i].bucket == bucket)
+            slots[commands[i].slot = taken[j++]] = i;
+    return 1;
+}
+
+static int by_name(const void *a, const void *b) {
+    return strcmp(commands[*(const int *)a].name, commands[*(const int *)b].name);
+}
+
+int main(void) {
+    int order[BUCKETS_NUMBER], sorted[COMMANDS_NUMBER];
+
+    memset(slots, -1, sizeof(slots));
+
+    for (int i = 0; i < COMMANDS_NUMBER; i++) {
+        if (strlen(commands[i].name) >= SHELL_NAME_CAP) {
+            fprintf(stderr, "Command name \"%s\" is too long.\n", commands[i].name);
+            exit(EXIT_FAILURE);
+        }
+        commands[i].bucket = shell_hash(commands[i].name, strlen(commands[i].name), 0) % BUCKETS_NUMBER;
+    }
+
+    /* Largest buckets first */
+    for (int i = 0; i < BUCKETS_NUMBER; i++)
+        order[i] = i;
+    for (int i = 0; i < BUCKETS_NUMBER; i++)
+    for (int j = i + 1; j < BUCKETS_NUMBER; j++)
+        if (bucket_size(order[j]) > bucket_size(order[i])) {
+            int t = order[i]; order[i] = order[j]; order[j] = t;
+        }
+
+    for (int i = 0; i < BUCKETS_NUMBER; i++) {
+        int d = 1;
+        for (; d < 256 && !try_displace(order[i], (uint8_t)d); d++)
+            ;
+
+        if (d == 256) {
+            fprintf(stderr, "Failed to build perfect hash for bucket %d.\n", order[i]);
+            exit(EXIT_FAILURE);
+        }
+        displace[order[i]] = (uint8_t)d;
+    }
+
+    for (int i = 0; i < COMMANDS_NUMBER; i++)
+        sorted[i] = i;
+    qsort(sorted, COMMANDS_NUMBER, sizeof(int), by_name);
+
+    printf("/* Generated by tools/shell_gen from include/commands.def. Do not edit. */\n");
+    printf("#ifndef _SHELL_TABLE_H\n#define _SHELL_TABLE_H\n\n");
+    printf("#define SHELL_COMMANDS_NUMBER   %d\n", COMMANDS_NUMBER);
+    printf("#define SHELL_HASH_BUCKETS      %d\n\n", BUCKETS_NUMBER);
+
+    for (int i = 0; i < COMMANDS_NUMBER; i++)
+        printf("static const char shell_help_%s[] PROGMEM = \"%s\";\n", commands[i].name, commands[i].help);
+
+    printf("\nstatic const uint8_t shell_hash_displace[SHELL_HASH_BUCKETS] PROGMEM = {");
+    for (int i = 0; i < BUCKETS_NUMBER; i++)
+        printf("%s%u", i ? ", " : " ", displace[i]);
+    printf(" };\n\n");
+
+    printf("/* Indexed by hash slot */\n");
+    printf("static const struct Shell_Command shell_commands[SHELL_COMMANDS_NUMBER] PROGMEM = {\n");
+    for (int s = 0; s < COMMANDS_NUMBER; s++) {
+        const struct Command_Info *c = &commands[slots[s]];
+        printf("    { \"%s\", shell_cmd_%s, %s, %s, shell_help_%s },\n", c->name, c->name, c->min, c->max, c->name);
+    }
+    printf("};\n\n");
+
+    printf("/* Hash slots sorted by name, for prefix completion */\n");
+    printf("static const uint8_t shell_prefix_index[SHELL_COMMANDS_NUMBER] PROGMEM = {");
+    for (int i = 0; i < COMMANDS_NUMBER; i++)
+        printf("%s%d", i ? ", " : " ", commands[sorted[i]].slot);
+    printf(" };\n\n#endif /* _SHELL_TABLE_H */\n");
+    return 0;
+}
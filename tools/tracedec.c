@@ -0,0 +1,200 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <stdbool.h>
+
+#include "trace.h"
+
+/* Turns 'trace' command UART dumps into Chrome trace JSON ( chrome://tracing, Perfetto ),
+   begin/end latency summary goes to stderr */
+
+#define EVENT(name, phase, label, lane) { #name, phase, label, lane },
+static const struct {
+    const char *name;
+    char phase;
+    const char *label;
+    int lane;
+} events[TRACE_EVENTS_NUMBER] = {
+    #include "trace.def"
+};
+#undef EVENT
+
+static const char *const lanes[] = { "tasks", "interrupts" };
+
+struct Span_Stats {
+    uint64_t open;
+    bool is_open;
+    unsigned long count;
+    uint64_t total, min, max;
+};
+
+static struct Span_Stats stats[TRACE_EVENTS_NUMBER];
+static bool first_event = true;
+
+static void __attribute__((noreturn)) usage(const char *self) {
+    fprintf(stderr, "usage: %s <dump> [out.json]  - decode captured 'trace' output\n", self);
+    exit(EXIT_FAILURE);
+}
+
+/* Index of begin event with the same label, spans are accounted there */
+static int span_of(int id) {
+    for (int i = 0; i < TRACE_EVENTS_NUMBER; i++)
+        if ((events[i].phase == 'B') && !strcmp(events[i].label, events[id].label))
+            return i;
+    return -1;
+}
+
+static void emit(FILE *out, int pid, int id, uint8_t arg, uint64_t us) {
+    fprintf(out, "%s\n  { \"name\": \"%s\", \"ph\": \"%c\", \"ts\": %" PRIu64 ", \"pid\": %d, \"tid\": %d",
+            first_event ? "" : ",", events[id].label, events[id].phase, us, pid, events[id].lane);
+
+    if (events[id].phase == 'i')
+        fprintf(out, ", \"s\": \"t\"");
+    if (events[id].phase != 'E')
+        fprintf(out, ", \"args\": { \"arg\": %u }", arg);
+
+    fputs(" }", out);
+    first_event = false;
+}
+
+static void account(int id, uint64_t us) {
+    const int span = span_of(id);
+    struct Span_Stats *s;
+
+    if (span < 0)
+        return;
+    s = &stats[span];
+
+    if (events[id].phase == 'B') {
+        s->open = us;
+        s->is_open = true;
+        return;
+    }
+
+    if (!s->is_open)
+        return;
+
+    const uint64_t d = us - s->open;
+    s->is_open = false;
+    s->total += d;
+    if (!s->count || (d < s->min))
+        s->min = d;
+    if (d > s->max)
+        s->max = d;
+    s->count ++;
+}
+
+/* One dump: header, then records oldest to newest */
+static size_t decode(FILE *out, int pid, const uint8_t *p, size_t len) {
+    struct Trace_Header header = { 0 };
+    uint64_t t = 0;
+    uint16_t prev = 0;
+
+    if (len >= sizeof(header))
+        memcpy(&header, p, sizeof(header));
+
+    const size_t size = sizeof(header) + (size_t)header.count * sizeof(struct Trace_Record);
+    if ((len < sizeof(header)) || (len < size)) {
+        fprintf(stderr, "dump %d: truncated\n", pid);
+        return len;
+    }
+
+    fprintf(stderr, "dump %d: %u records, %u lost\n", pid, header.count, header.lost);
+    for (int i = 0; i < TRACE_EVENTS_NUMBER; i++)
+        stats[i].is_open = false;
+
+    for (unsigned i = 0; i < header.count; i++) {
+        struct Trace_Record r;
+        memcpy(&r, p + sizeof(header) + i * sizeof(r), sizeof(r));
+
+        if (r.id >= TRACE_EVENTS_NUMBER) {
+            fprintf(stderr, "dump %d: bad event id %u\n", pid, r.id);
+            continue;
+        }
+
+        /* 16-bit time, gaps are assumed shorter than one wrap */
+        t = i ? t + (uint16_t)(r.time - prev) : r.time;
+        prev = r.time;
+
+        const uint64_t us = t * header.unit_us;
+
+        /* End without begin: its begin was overwritten in ring */
+        const int span = span_of(r.id);
+        if ((events[r.id].phase == 'E') && ((span < 0) || !stats[span].is_open))
+            continue;
+
+        emit(out, pid, r.id, r.arg, us);
+        account(r.id, us);
+    }
+
+    return size;
+}
+
+int main(int argc, char **argv) {
+    if ((argc < 2) || (argc > 3))
+        usage(argv[0]);
+
+    FILE *in = fopen(argv[1], "rb");
+    if (!in) {
+        perror(argv[1]);
+        return EXIT_FAILURE;
+    }
+
+    fseek(in, 0, SEEK_END);
+    const long len = ftell(in);
+    fseek(in, 0, SEEK_SET);
+
+    uint8_t *data = malloc(len > 0 ? (size_t)len : 1);
+    if (!data || (fread(data, 1, (size_t)len, in) != (size_t)len)) {
+        fprintf(stderr, "%s: read failed\n", argv[1]);
+        return EXIT_FAILURE;
+    }
+    fclose(in);
+
+    FILE *out = (argc == 3) ? fopen(argv[2], "w") : stdout;
+    if (!out) {
+        perror(argv[2]);
+        return EXIT_FAILURE;
+    }
+
+    fputs("{ \"displayTimeUnit\": \"ms\", \"traceEvents\": [", out);
+
+    /* Captured serial log may have other output around dumps, scan for magic */
+    int dumps = 0;
+    for (long pos = 0; pos + 4 <= len; ) {
+        if (memcmp(data + pos, TRACE_MAGIC, 4)) {
+            pos ++;
+            continue;
+        }
+
+        for (int lane = 0; lane < 2; lane++) {
+            fprintf(out, "%s\n  { \"name\": \"thread_name\", \"ph\": \"M\", \"pid\": %d, \"tid\": %d, "
+                         "\"args\": { \"name\": \"%s\" } }", first_event ? "" : ",", dumps, lane, lanes[lane]);
+            first_event = false;
+        }
+
+        pos += decode(out, dumps ++, data + pos, (size_t)(len - pos));
+    }
+
+    fputs("\n] }\n", out);
+    if (out != stdout)
+        fclose(out);
+    free(data);
+
+    if (!dumps) {
+        fprintf(stderr, "%s: no trace dump found\n", argv[1]);
+        return EXIT_FAILURE;
+    }
+
+    /* Span durations over all dumps */
+    fprintf(stderr, "%-12s %8s %8s %8s %8s\n", "span", "count", "min us", "avg us", "max us");
+    for (int i = 0; i < TRACE_EVENTS_NUMBER; i++) {
+        if (!stats[i].count)
+            continue;
+        fprintf(stderr, "%-12s %8lu %8" PRIu64 " %8" PRIu64 " %8" PRIu64 "\n", events[i].label, stats[i].count,
+                stats[i].min, stats[i].total / stats[i].count, stats[i].max);
+    }
+
+    return EXIT_SUCCESS;
+}
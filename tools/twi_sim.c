@@ -0,0 +1,229 @@
+/* Recursive mutexes and nanosleep under -std=c11 */
+#define _DEFAULT_SOURCE
+
+#include <stdio.h>
+#include <string.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <time.h>
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <util/twi.h>
+
+#include "twi.h"
+#include "eeprom24.h"
+#include "memstat.h"
+#include "twi_sim.h"
+
+/* TWI hardware and one 24LC256 on its bus. drivers/twi.c runs unchanged on top: a thread acts
+   as the peripheral, takes each TWCR write with TWINT set as a command and calls the ISR back */
+
+volatile uint8_t TWBR, TWSR, TWDR, TWCR;
+volatile uint8_t PORTC, DDRC;
+volatile uint16_t SP = 0xFFFF;
+
+volatile uint16_t memstat_isr_sp[MEMSTAT_ISRS_NUMBER];
+
+void twi_sim_vect(void);
+
+enum Bus_Phase {
+    PHASE_NONE = 0,             /* After STOP or NACK, only START is valid */
+    PHASE_ADDRESS,              /* START sent, TWDR holds SLA+R/W */
+    PHASE_WRITE,
+    PHASE_READ,
+};
+
+static uint8_t memory[EEPROM24_SIZE];
+static uint16_t pointer = 0;
+static double busy_until = 0;
+static struct TWI_Sim_Stats stats = { 0 };
+
+static struct {
+    enum Bus_Phase phase;
+    bool owned;                 /* START sent and no STOP yet */
+    bool acked;                 /* Slave took its address since last STOP */
+    bool wrote;                 /* Data bytes since last STOP start a write cycle */
+    uint8_t header;             /* Address bytes received in this write */
+    uint16_t address;
+} bus = { 0 };
+
+static pthread_mutex_t irq_lock;
+static pthread_t hardware;
+static bool running = false;
+
+void twi_sim_irq_lock(void) {
+    pthread_mutex_lock(&irq_lock);
+}
+
+void twi_sim_irq_unlock(void) {
+    pthread_mutex_unlock(&irq_lock);
+}
+
+void ros_set_pin_direction(volatile uint8_t *port, volatile uint8_t *ddr, int pin, enum Pin_Direction dir) {
+    (void) port;
+    (void) ddr;
+    (void) pin;
+    (void) dir;
+}
+
+static inline void bus_bits(unsigned bits) {
+    stats.bus_us += TWI_SIM_BIT_US * bits;
+}
+
+static void bus_stop(void) {
+    bus_bits(1);
+
+    if (bus.acked)
+        stats.transactions ++;
+
+    if (bus.wrote) {
+        busy_until = stats.bus_us + TWI_SIM_WRITE_CYCLE_US;
+        stats.writes ++;
+    }
+
+    bus.phase = PHASE_NONE;
+    bus.owned = bus.acked = bus.wrote = false;
+}
+
+/* Slave NACKs its address while the write cycle runs */
+static uint8_t bus_address(uint8_t sla) {
+    const bool read = sla & TW_READ;
+
+    bus_bits(9);
+
+    if (((sla >> 1) != EEPROM24_ADDRESS) || (stats.bus_us < busy_until)) {
+        stats.polls ++;
+        bus.phase = PHASE_NONE;
+        return read ? TW_MR_SLA_NACK : TW_MT_SLA_NACK;
+    }
+
+    bus.acked = true;
+    bus.header = 0;
+    bus.phase = read ? PHASE_READ : PHASE_WRITE;
+    return read ? TW_MR_SLA_ACK : TW_MT_SLA_ACK;
+}
+
+/* Two address bytes, then data: address counter wraps inside the page like the real part does */
+static uint8_t bus_write(uint8_t byte) {
+    bus_bits(9);
+    stats.bytes ++;
+
+    if (bus.header < 2) {
+        bus.address = (uint16_t)((bus.address << 8) | byte);
+        if (++ bus.header == 2)
+            pointer = bus.address & (EEPROM24_SIZE - 1);
+
+        return TW_MT_DATA_ACK;
+    }
+
+    const uint16_t base = pointer & ~(EEPROM24_PAGE_SIZE - 1);
+
+    memory[pointer] = byte;
+    pointer = base | ((pointer + 1) & (EEPROM24_PAGE_SIZE - 1));
+    bus.wrote = true;
+    return TW_MT_DATA_ACK;
+}
+
+static uint8_t bus_read(bool ack) {
+    bus_bits(9);
+    stats.bytes ++;
+
+    TWDR = memory[pointer];
+    pointer = (pointer + 1) & (EEPROM24_SIZE - 1);
+    return ack ? TW_MR_DATA_ACK : TW_MR_DATA_NACK;
+}
+
+/* Carries out one TWCR command, returns new TWSR or -1 when TWINT is not raised ( plain STOP ) */
+static int bus_command(uint8_t twcr) {
+    if (twcr & BIT(TWSTO)) {
+        if (bus.owned)
+            bus_stop();
+
+        if (!(twcr & BIT(TWSTA)))
+            return -1;
+    }
+
+    if (twcr & BIT(TWSTA)) {
+        const uint8_t status = bus.owned ? TW_REP_START : TW_START;
+
+        bus_bits(1);
+        bus.owned = true;
+        bus.phase = PHASE_ADDRESS;
+        return status;
+    }
+
+    switch (bus.phase) {
+    case PHASE_ADDRESS: return bus_address(TWDR);
+    case PHASE_WRITE:   return bus_write(TWDR);
+    case PHASE_READ:    return bus_read(twcr & BIT(TWEA));
+    default:            return TW_BUS_ERROR;
+    }
+}
+
+static void *hardware_run(void *arg) {
+    (void) arg;
+
+    for (;;) {
+        bool idle = true;
+
+        twi_sim_irq_lock();
+
+        if ((TWCR & BIT(TWEN)) && (TWCR & BIT(TWINT))) {
+            const uint8_t twcr = TWCR;
+            int status;
+
+            /* Writing one clears the flag, STA and STO are cleared by hardware */
+            TWCR = twcr & ~(BIT(TWINT) | BIT(TWSTA) | BIT(TWSTO));
+            idle = false;
+
+            if ((status = bus_command(twcr)) >= 0) {
+                TWSR = (uint8_t)status;
+                if (twcr & BIT(TWIE))
+                    twi_sim_vect();
+            }
+        }
+
+        twi_sim_irq_unlock();
+
+        /* Lets the main thread take the lock */
+        if (idle)
+            nanosleep(&(struct timespec){ 0, 1000 }, NULL);
+    }
+
+    return NULL;
+}
+
+void twi_sim_reset(void) {
+    pthread_mutexattr_t attr;
+
+    if (!running) {
+        pthread_mutexattr_init(&attr);
+        pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+        pthread_mutex_init(&irq_lock, &attr);
+        pthread_mutexattr_destroy(&attr);
+
+        if (pthread_create(&hardware, NULL, hardware_run, NULL) != 0) {
+            perror("pthread_create");
+            return;
+        }
+        running = true;
+    }
+
+    twi_sim_irq_lock();
+    memset(memory, 0xFF, sizeof(memory));
+    memset(&bus, 0, sizeof(bus));
+    memset(&stats, 0, sizeof(stats));
+    pointer = 0;
+    busy_until = 0;
+    TWCR = TWSR = 0;
+    twi_sim_irq_unlock();
+}
+
+uint8_t *twi_sim_memory(void) {
+    return memory;
+}
+
+const struct TWI_Sim_Stats *twi_sim_stats(void) {
+    return &stats;
+}
@@ -0,0 +1,22 @@
+#ifndef _TWI_SIM_H
+#define _TWI_SIM_H
+
+#include <inttypes.h>
+
+/* Register-level model of the TWI peripheral and one 24LC256, drives drivers/twi.c on host */
+#define TWI_SIM_BIT_US          (1e6 / TWI_FREQUENCY)
+#define TWI_SIM_WRITE_CYCLE_US  5000.0
+
+struct TWI_Sim_Stats {
+    double bus_us;              /* Simulated time since reset */
+    unsigned long transactions;
+    unsigned long polls;        /* Address NACKs while write cycle ran */
+    unsigned long writes;       /* Page writes started */
+    unsigned long bytes;
+};
+
+void twi_sim_reset(void);          /* Before twi_init() */
+uint8_t *twi_sim_memory(void);
+const struct TWI_Sim_Stats *twi_sim_stats(void);
+
+#endif /* _TWI_SIM_H */